@@ -5,6 +5,7 @@
 #include "Common/Hash.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include "Common/BitUtils.h"
 #include "Common/CPUDetect.h"
@@ -22,6 +23,7 @@
 namespace Common
 {
 static u64 (*ptrHashFunction)(const u8* src, u32 len, u32 samples) = nullptr;
+static u64 (*ptrFullHashFunction)(const u8* src, u32 len, u32 samples) = nullptr;
 
 // uint32_t
 // WARNING - may read one more byte!
@@ -505,8 +507,124 @@ static u64 GetMurmurHash3(const u8* src, u32 len, u32 samples)
 }
 #endif
 
+#if defined(_M_X86_64)
+
+// Full-length hash in the style of XXH3. Eight 64-bit accumulators consume the input 64 bytes at a
+// time, mixing each word with a secret through a 32x32->64-bit multiply, so that a whole stripe
+// takes only a handful of AVX2 instructions. Used in place of CRC32 when every word is hashed.
+constexpr u32 STRIPE_LANES = 8;
+constexpr u32 STRIPE_SIZE = STRIPE_LANES * sizeof(u64);
+constexpr u32 SECRET_LANES = 24;
+// Each stripe of a block uses the secret at a different offset, one lane further along.
+constexpr u32 STRIPES_PER_BLOCK = SECRET_LANES - STRIPE_LANES;
+constexpr u32 SCRAMBLE_LANE = SECRET_LANES - STRIPE_LANES;
+
+constexpr u32 PRIME32_1 = 0x9E3779B1;
+constexpr u64 PRIME64_1 = 0x9E3779B185EBCA87;
+constexpr u64 PRIME64_2 = 0xC2B2AE3D27D4EB4F;
+constexpr u64 PRIME64_3 = 0x165667B19E3779F9;
+
+static constexpr std::array<u64, SECRET_LANES> s_stripe_secret = [] {
+  // splitmix64
+  std::array<u64, SECRET_LANES> secret{};
+  u64 state = PRIME64_3;
+  for (u64& value : secret)
+  {
+    state += 0x9E3779B97F4A7C15;
+    u64 z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    value = z ^ (z >> 31);
+  }
+  return secret;
+}();
+
+static constexpr std::array<u64, STRIPE_LANES> s_stripe_initial_accumulators = {
+    PRIME32_1, PRIME64_1, PRIME64_2, PRIME64_3, ~PRIME32_1, ~PRIME64_1, ~PRIME64_2, ~PRIME64_3};
+
+FUNCTION_TARGET_AVX2
+static __m256i AccumulateStripeAVX2(__m256i acc, const u8* data, const u64* secret)
+{
+  const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  const __m256i key =
+      _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret)));
+  // acc[i] += low(key[i]) * high(key[i]); acc[i ^ 1] += value[i]
+  const __m256i product = _mm256_mul_epu32(key, _mm256_srli_epi64(key, 32));
+  const __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+  return _mm256_add_epi64(acc, _mm256_add_epi64(product, swapped));
+}
+
+FUNCTION_TARGET_AVX2
+static __m256i ScrambleStripeAccumulatorsAVX2(__m256i acc, const u64* secret)
+{
+  acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+  acc = _mm256_xor_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret)));
+  const __m256i prime = _mm256_set1_epi32(PRIME32_1);
+  const __m256i low = _mm256_mul_epu32(acc, prime);
+  const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime);
+  return _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+}
+
+FUNCTION_TARGET_AVX2
+static u64 GetStripeHashAVX2(const u8* src, u32 len, u32 samples)
+{
+  const auto* initial = reinterpret_cast<const __m256i*>(s_stripe_initial_accumulators.data());
+  __m256i acc_low = _mm256_loadu_si256(initial + 0);
+  __m256i acc_high = _mm256_loadu_si256(initial + 1);
+
+  const u32 num_stripes = len / STRIPE_SIZE;
+  u32 stripe_in_block = 0;
+  for (u32 i = 0; i < num_stripes; i++)
+  {
+    const u8* data = src + i * STRIPE_SIZE;
+    const u64* secret = &s_stripe_secret[stripe_in_block];
+    acc_low = AccumulateStripeAVX2(acc_low, data, secret);
+    acc_high = AccumulateStripeAVX2(acc_high, data + 32, secret + 4);
+
+    if (++stripe_in_block == STRIPES_PER_BLOCK)
+    {
+      acc_low = ScrambleStripeAccumulatorsAVX2(acc_low, &s_stripe_secret[SCRAMBLE_LANE]);
+      acc_high = ScrambleStripeAccumulatorsAVX2(acc_high, &s_stripe_secret[SCRAMBLE_LANE + 4]);
+      stripe_in_block = 0;
+    }
+  }
+
+  if (len % STRIPE_SIZE != 0)
+  {
+    std::array<u8, STRIPE_SIZE> last_stripe{};
+    std::memcpy(last_stripe.data(), src + num_stripes * STRIPE_SIZE, len % STRIPE_SIZE);
+    const u64* secret = &s_stripe_secret[stripe_in_block];
+    acc_low = AccumulateStripeAVX2(acc_low, last_stripe.data(), secret);
+    acc_high = AccumulateStripeAVX2(acc_high, last_stripe.data() + 32, secret + 4);
+  }
+
+  alignas(32) std::array<u64, STRIPE_LANES> acc;
+  _mm256_store_si256(reinterpret_cast<__m256i*>(&acc[0]), acc_low);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(&acc[4]), acc_high);
+
+  u64 h = len * PRIME64_1;
+  for (u32 i = 0; i < STRIPE_LANES; i++)
+  {
+    u64 k = acc[i] ^ s_stripe_secret[i];
+    k ^= k >> 33;
+    k *= PRIME64_2;
+    k ^= k >> 29;
+    h = Common::RotateLeft(h ^ k, 27) * PRIME64_1 + PRIME64_3;
+  }
+
+  h ^= h >> 37;
+  h *= PRIME64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+#endif
+
 u64 GetHash64(const u8* src, u32 len, u32 samples)
 {
+  if (samples == 0)
+    return ptrFullHashFunction(src, len, samples);
+
   return ptrHashFunction(src, len, samples);
 }
 
@@ -529,5 +647,13 @@ void SetHash64Function()
   {
     ptrHashFunction = &GetMurmurHash3;
   }
+
+  // Hashing every byte is bound by how fast the data can be mixed, so there is a separate choice
+  // for that case.
+  ptrFullHashFunction = ptrHashFunction;
+#if defined(_M_X86_64)
+  if (cpu_info.bAVX2)
+    ptrFullHashFunction = &GetStripeHashAVX2;
+#endif
 }
 }  // namespace Common
@@ -9,23 +9,42 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/Version.h"
 
 // On disk format:
 // header{
 // u32 'DCAC';
-// u32 version;  // svn_rev
 // u16 sizeof(key_type);
 // u16 sizeof(value_type);
+// char version[40];  // scm_rev
+// u32 format;
 //}
 
 // key_value_pair{
 // u32 value_size;
 // key_type   key;
 // value_type[value_size]   value;
+// u32 entry_number;
+//}
+
+// Written after the last pair when the cache is closed:
+// index{
+// index_entry[num_entries]{
+//   u64 key_hash;
+//   u64 offset;  // of the latest pair with the key
+// }
+// u64 data_end;  // end of the last pair
+// u32 num_pairs;
+// u32 num_entries;
+// u32 'DIDX';
+// u32 padding;
 //}
 
 template <typename K, typename V>
@@ -36,11 +55,16 @@ public:
 };
 
 // Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
 // Keys and values can contain any characters, including \0.
 //
+// The file is memory-mapped, so values are read straight from the file data. When the cache is
+// closed, an index of the latest pair for every key is written after the pairs, which lets the
+// next open find all the values without parsing every pair. If the index is missing, e.g. because
+// Dolphin crashed, the pairs are parsed to rebuild it. Pairs which have been superseded by a later
+// one with the same key are skipped, and the file is compacted on close once they take up a good
+// part of it.
+//
 // Suitable for caching generated shader bytecode between executions.
-// Not tuned for extreme performance but should be reasonably fast.
 // Does not support keys or values larger than 2GB, which should be reasonable.
 // Keys must have non-zero length; values can have zero length.
 
@@ -51,90 +75,373 @@ template <typename K, typename V>
 class LinearDiskCache
 {
 public:
-  // return number of read entries
-  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  ~LinearDiskCache() { Close(); }
+
+  // Opens the cache, creating it if it doesn't exist or is invalid. Values can then be found with
+  // Lookup(). Returns the number of keys in the cache.
+  u32 Open(const std::string& filename)
   {
     // Since we're reading/writing directly to the storage of K instances,
     // K must be trivially copyable.
     static_assert(std::is_trivially_copyable<K>::value, "K must be a trivially copyable type");
+    // Values are passed to the reader straight from the file data, which has no alignment.
+    static_assert(alignof(V) == 1, "V must not require alignment");
 
     // close any currently opened file
     Close();
+    m_filename = filename;
+    m_index.clear();
     m_num_entries = 0;
+    m_data_end = sizeof(Header);
+    m_mapped_data_end = 0;
+    m_superseded_size = 0;
+    m_index_on_disk = false;
+    m_index_dirty = false;
 
     // try opening for reading/writing
-    m_file.Open(filename, "r+b");
-
-    const u64 file_size = m_file.GetSize();
-
     m_header.Init();
-    if (m_file.IsOpen() && ValidateHeader())
+    if (m_file.Open(filename, "r+b") && ValidateHeader())
     {
-      // good header, read some key/value pairs
-      K key;
-
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
-
-      while (m_file.ReadArray(&value_size, 1))
+      const u64 file_size = m_file.GetSize();
+      if (file_size == sizeof(Header) ||
+          (m_mapping.Open(filename) && m_mapping.GetSize() == file_size))
       {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
-          break;
-        }
-
-        m_num_entries++;
-      }
-      m_file.Clear();
-      m_file.Seek(last_valid_value_start, SEEK_SET);
+        if (!ReadIndex())
+          ScanPairs();
 
-      return m_num_entries;
+        m_mapped_data_end = m_data_end;
+        m_file.Seek(m_data_end, SEEK_SET);
+        return static_cast<u32>(m_index.size());
+      }
     }
 
     // failed to open file for reading or bad header
     // close and recreate file
     Close();
-    m_file.Open(filename, "wb");
+    m_index.clear();
+    m_num_entries = 0;
+    m_data_end = sizeof(Header);
+    m_superseded_size = 0;
+    m_file.Open(filename, "w+b");
     WriteHeader();
+    m_index_dirty = true;
     return 0;
   }
 
+  // Opens the cache and passes the latest value of every key to the reader, in the order they
+  // were appended. Returns the number of read entries.
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  {
+    Open(filename);
+
+    std::vector<u64> offsets;
+    offsets.reserve(m_index.size());
+    for (const auto& entry : m_index)
+    {
+      if (IsMapped(entry.second))
+        offsets.push_back(entry.second.offset);
+    }
+    std::sort(offsets.begin(), offsets.end());
+
+    for (const u64 offset : offsets)
+    {
+      const u8* pair = m_mapping.GetData() + offset;
+      u32 value_size;
+      K key;
+      std::memcpy(&value_size, pair, sizeof(value_size));
+      std::memcpy(&key, pair + sizeof(value_size), sizeof(K));
+      reader.Read(key, reinterpret_cast<const V*>(pair + sizeof(value_size) + sizeof(K)),
+                  value_size);
+    }
+
+    return static_cast<u32>(offsets.size());
+  }
+
+  // Returns the latest value stored for the key and its size, pointing into the mapped file, or
+  // null if there is none. Values appended since the cache was opened can't be looked up.
+  const V* Lookup(const K& key, u32* value_size) const
+  {
+    const auto it = m_index.find(HashKey(key));
+    if (it == m_index.end() || !IsMapped(it->second))
+      return nullptr;
+
+    const u8* pair = m_mapping.GetData() + it->second.offset;
+    if (std::memcmp(pair + sizeof(u32), &key, sizeof(K)) != 0)
+      return nullptr;
+
+    std::memcpy(value_size, pair, sizeof(u32));
+    return reinterpret_cast<const V*>(pair + sizeof(u32) + sizeof(K));
+  }
+
   void Sync() { m_file.Flush(); }
   void Close()
   {
+    if (m_file.IsOpen() && m_index_dirty)
+    {
+      if (m_superseded_size > 0 && m_superseded_size >= (m_data_end - sizeof(Header)) / 4)
+        Compact();
+      else
+        WriteIndex();
+    }
+
+    m_mapping.Close();
     if (m_file.IsOpen())
       m_file.Close();
+    m_index_dirty = false;
   }
 
   // Appends a key-value pair to the store.
   void Append(const K& key, const V* value, u32 value_size)
   {
-    // TODO: Should do a check that we don't already have "key"? (I think each caller does that
-    // already.)
+    // The pairs are written over the index, so make sure it isn't used if we don't get to write
+    // a new one.
+    if (m_index_on_disk)
+    {
+      const Footer footer{};
+      m_file.Seek(-static_cast<s64>(sizeof(Footer)), SEEK_END);
+      m_file.WriteArray(&footer, 1);
+      m_file.Seek(m_data_end, SEEK_SET);
+      m_index_on_disk = false;
+    }
+
     m_file.WriteArray(&value_size, 1);
     m_file.WriteArray(&key, 1);
     m_file.WriteArray(value, value_size);
     m_num_entries++;
     m_file.WriteArray(&m_num_entries, 1);
+
+    AddToIndex(HashKey(key), m_data_end, GetPairSize(value_size));
+    m_data_end += GetPairSize(value_size);
+    m_index_dirty = true;
   }
 
 private:
+  static constexpr u32 INDEX_MAGIC = 0x58444944;  // DIDX
+
+  struct IndexEntry
+  {
+    u64 key_hash;
+    u64 offset;
+  };
+
+  struct Footer
+  {
+    u64 data_end;
+    u32 num_pairs;
+    u32 num_entries;
+    u32 magic;
+    u32 padding;
+  };
+
+  struct Pair
+  {
+    u64 offset;
+    u64 size;
+  };
+
+  // Pairs appended since the cache was opened aren't in the mapped part of the file.
+  bool IsMapped(const Pair& pair) const { return pair.offset + pair.size <= m_mapped_data_end; }
+
+  static u64 GetPairSize(u32 value_size)
+  {
+    return sizeof(u32) + sizeof(K) + u64(value_size) * sizeof(V) + sizeof(u32);
+  }
+
+  static u64 HashKey(const K& key)
+  {
+    // FNV-1a. It has to stay the same across runs and machines, as the hashes are stored on disk.
+    const u8* data = reinterpret_cast<const u8*>(&key);
+    u64 hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < sizeof(K); i++)
+      hash = (hash ^ data[i]) * 0x100000001B3ULL;
+    return hash;
+  }
+
+  void AddToIndex(u64 key_hash, u64 offset, u64 size)
+  {
+    // Distinct keys with the same hash are treated as the same key. The older pair is dropped,
+    // which just means that its value has to be generated again.
+    const auto result = m_index.try_emplace(key_hash, Pair{offset, size});
+    if (!result.second)
+    {
+      m_superseded_size += result.first->second.size;
+      result.first->second = {offset, size};
+    }
+  }
+
+  // Returns the size of the pair at offset in the mapped file, or 0 if it isn't a valid pair.
+  u64 GetMappedPairSize(u64 offset, u64 data_end, u32 entry_number) const
+  {
+    u32 value_size;
+    if (data_end - offset < sizeof(value_size))
+      return 0;
+    std::memcpy(&value_size, m_mapping.GetData() + offset, sizeof(value_size));
+    const u64 pair_size = GetPairSize(value_size);
+    if (pair_size > data_end - offset)
+      return 0;
+
+    u32 stored_entry_number;
+    std::memcpy(&stored_entry_number,
+                m_mapping.GetData() + offset + pair_size - sizeof(stored_entry_number),
+                sizeof(stored_entry_number));
+    if (entry_number != 0 && stored_entry_number != entry_number)
+      return 0;
+
+    return pair_size;
+  }
+
+  bool ReadIndex()
+  {
+    const u64 file_size = m_mapping.GetSize();
+    if (file_size < sizeof(Header) + sizeof(Footer))
+      return false;
+
+    Footer footer;
+    std::memcpy(&footer, m_mapping.GetData() + file_size - sizeof(Footer), sizeof(Footer));
+    const u64 index_size = u64(footer.num_entries) * sizeof(IndexEntry);
+    if (footer.magic != INDEX_MAGIC || footer.data_end < sizeof(Header) ||
+        footer.data_end > file_size || file_size - footer.data_end != index_size + sizeof(Footer))
+    {
+      return false;
+    }
+
+    const u8* entries = m_mapping.GetData() + footer.data_end;
+    for (u32 i = 0; i < footer.num_entries; i++)
+    {
+      IndexEntry entry;
+      std::memcpy(&entry, entries + i * sizeof(IndexEntry), sizeof(IndexEntry));
+      const u64 pair_size = entry.offset >= sizeof(Header) && entry.offset < footer.data_end ?
+                                GetMappedPairSize(entry.offset, footer.data_end, 0) :
+                                0;
+      K key;
+      if (pair_size != 0)
+        std::memcpy(&key, m_mapping.GetData() + entry.offset + sizeof(u32), sizeof(K));
+      if (pair_size == 0 || HashKey(key) != entry.key_hash)
+      {
+        m_index.clear();
+        m_superseded_size = 0;
+        return false;
+      }
+      AddToIndex(entry.key_hash, entry.offset, pair_size);
+    }
+
+    m_num_entries = footer.num_pairs;
+    m_data_end = footer.data_end;
+    m_superseded_size = m_data_end - sizeof(Header);
+    for (const auto& pair : m_index)
+      m_superseded_size -= std::min(m_superseded_size, pair.second.size);
+    m_index_on_disk = true;
+    return true;
+  }
+
+  void ScanPairs()
+  {
+    const u64 file_size = m_mapping.GetSize();
+    u64 offset = sizeof(Header);
+    while (offset < file_size)
+    {
+      const u64 pair_size = GetMappedPairSize(offset, file_size, m_num_entries + 1);
+      if (pair_size == 0)
+        break;
+
+      K key;
+      std::memcpy(&key, m_mapping.GetData() + offset + sizeof(u32), sizeof(K));
+      AddToIndex(HashKey(key), offset, pair_size);
+      offset += pair_size;
+      m_num_entries++;
+    }
+
+    m_data_end = offset;
+    m_index_dirty = true;
+  }
+
+  bool WriteIndex(File::IOFile& file) const
+  {
+    std::vector<IndexEntry> entries;
+    entries.reserve(m_index.size());
+    for (const auto& pair : m_index)
+      entries.push_back({pair.first, pair.second.offset});
+    std::sort(entries.begin(), entries.end(),
+              [](const IndexEntry& a, const IndexEntry& b) { return a.offset < b.offset; });
+
+    const Footer footer{m_data_end, m_num_entries, static_cast<u32>(entries.size()), INDEX_MAGIC,
+                        0};
+    return file.Seek(m_data_end, SEEK_SET) && file.WriteArray(entries.data(), entries.size()) &&
+           file.WriteArray(&footer, 1);
+  }
+
+  void WriteIndex()
+  {
+    // Anything after the index is left over from pairs which weren't valid.
+    const bool written = WriteIndex(m_file) && m_file.Flush();
+    const u64 file_size = m_file.Tell();
+    m_mapping.Close();
+    if (written)
+      m_file.Resize(file_size);
+  }
+
+  // Rewrites the file with only the latest pair of every key.
+  void Compact()
+  {
+    std::vector<Pair> pairs;
+    pairs.reserve(m_index.size());
+    for (const auto& pair : m_index)
+      pairs.push_back(pair.second);
+    std::sort(pairs.begin(), pairs.end(),
+              [](const Pair& a, const Pair& b) { return a.offset < b.offset; });
+
+    const std::string temp_filename = m_filename + ".compact";
+    File::IOFile temp_file(temp_filename, "wb");
+    bool success = temp_file.WriteArray(&m_header, 1);
+
+    std::unordered_map<u64, Pair> new_index;
+    new_index.reserve(m_index.size());
+    u64 new_data_end = sizeof(Header);
+    u32 new_num_entries = 0;
+    std::vector<u8> buffer;
+    for (const Pair& pair : pairs)
+    {
+      if (!success)
+        break;
+
+      // Pairs appended since opening aren't mapped, so they are read back from the file.
+      buffer.resize(pair.size);
+      if (IsMapped(pair))
+      {
+        std::memcpy(buffer.data(), m_mapping.GetData() + pair.offset, pair.size);
+      }
+      else
+      {
+        m_file.Flush();
+        success = m_file.Seek(pair.offset, SEEK_SET) && m_file.ReadBytes(buffer.data(), pair.size);
+      }
+
+      new_num_entries++;
+      std::memcpy(&buffer[pair.size - sizeof(new_num_entries)], &new_num_entries,
+                  sizeof(new_num_entries));
+      K key;
+      std::memcpy(&key, &buffer[sizeof(u32)], sizeof(K));
+      new_index[HashKey(key)] = {new_data_end, pair.size};
+      new_data_end += pair.size;
+      success = success && temp_file.WriteBytes(buffer.data(), buffer.size());
+    }
+
+    if (success)
+    {
+      m_index = std::move(new_index);
+      m_data_end = new_data_end;
+      m_num_entries = new_num_entries;
+      m_superseded_size = 0;
+      success = WriteIndex(temp_file);
+    }
+    temp_file.Close();
+    m_mapping.Close();
+    m_file.Close();
+
+    if (!success || !File::Rename(temp_filename, m_filename))
+      File::Delete(temp_filename);
+  }
+
   void WriteHeader() { m_file.WriteArray(&m_header, 1); }
   bool ValidateHeader()
   {
@@ -158,9 +465,22 @@ private:
     const u16 key_t_size = sizeof(K);
     const u16 value_t_size = sizeof(V);
     char ver[40] = {};
+    // Bumped when the layout of the file changes.
+    const u32 format = 2;
 
   } m_header;
 
   File::IOFile m_file;
-  u32 m_num_entries;
+  File::MappedFile m_mapping;
+  std::string m_filename;
+  // Key hash to the latest pair with the key.
+  std::unordered_map<u64, Pair> m_index;
+  u64 m_data_end = 0;
+  u64 m_mapped_data_end = 0;
+  u64 m_superseded_size = 0;
+  u32 m_num_entries = 0;
+  // Whether the file ends with a valid index, which has to be invalidated before appending.
+  bool m_index_on_disk = false;
+  // Whether the index on disk is missing or out of date.
+  bool m_index_dirty = false;
 };
@@ -0,0 +1,86 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// a lockless thread-safe,
+// multiple producer, single consumer queue
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+// Pushing is wait-free: a producer swaps its element in as the new head, then links the previous
+// head to it. Until that link is stored, the consumer sees the queue end at the previous element,
+// so an element may become visible slightly after Push returns, but elements from the same
+// producer are always popped in the order they were pushed.
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue() : m_read_ptr(new Node()) { m_write_ptr.store(m_read_ptr); }
+  ~MPSCQueue()
+  {
+    Clear();
+    delete m_read_ptr;
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  // Can be called from any thread.
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    Node* new_ptr = new Node(std::forward<Arg>(t));
+    Node* prev_ptr = m_write_ptr.exchange(new_ptr, std::memory_order_acq_rel);
+    prev_ptr->next.store(new_ptr, std::memory_order_release);
+  }
+
+  // Only the consumer thread may call the functions below.
+  bool Empty() const { return !m_read_ptr->next.load(std::memory_order_acquire); }
+
+  bool Pop(T& t)
+  {
+    Node* next_ptr = m_read_ptr->next.load(std::memory_order_acquire);
+    if (!next_ptr)
+      return false;
+
+    // The popped element's node becomes the new stub, which keeps the queue from ever being
+    // completely empty, so producers never have to touch m_read_ptr.
+    t = std::move(next_ptr->current);
+    delete m_read_ptr;
+    m_read_ptr = next_ptr;
+    return true;
+  }
+
+  // not thread-safe
+  void Clear()
+  {
+    while (Node* next_ptr = m_read_ptr->next.load())
+    {
+      delete m_read_ptr;
+      m_read_ptr = next_ptr;
+    }
+    m_read_ptr->current = T();
+  }
+
+private:
+  struct Node
+  {
+    Node() = default;
+    template <typename Arg>
+    explicit Node(Arg&& t) : current(std::forward<Arg>(t))
+    {
+    }
+
+    T current{};
+    std::atomic<Node*> next{nullptr};
+  };
+
+  std::atomic<Node*> m_write_ptr;
+  Node* m_read_ptr;
+};
+}  // namespace Common
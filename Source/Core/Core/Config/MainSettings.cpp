@@ -25,6 +25,11 @@ const Info<bool> MAIN_LOAD_IPL_DUMP{{System::Main, "Core", "LoadIPLDump"}, true}
 const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
+const Info<bool> MAIN_JIT_PERSISTENT_CACHE{{System::Main, "Core", "JITPersistentCache"}, false};
+const Info<bool> MAIN_JIT_TIERED_COMPILATION{{System::Main, "Core", "JITTieredCompilation"},
+                                             false};
+const Info<bool> MAIN_JIT_INTERPRET_COLD_BLOCKS{{System::Main, "Core", "JITInterpretColdBlocks"},
+                                                false};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_TIMING_VARIANCE{{System::Main, "Core", "TimingVariance"}, 40};
@@ -114,6 +119,14 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<int> MAIN_STATE_COMPRESSION_LEVEL{{System::Main, "Core", "StateCompressionLevel"}, 1};
+const Info<bool> MAIN_REWIND_ENABLE{{System::Main, "Core", "EnableRewind"}, false};
+// In fields. This is raised automatically if captures don't fit in the per-frame budget.
+const Info<int> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 30};
+// In MiB.
+const Info<int> MAIN_REWIND_MEMORY_BUDGET{{System::Main, "Core", "RewindMemoryBudget"}, 256};
+// In microseconds of CPU thread time per field.
+const Info<int> MAIN_REWIND_FRAME_BUDGET{{System::Main, "Core", "RewindFrameBudget"}, 1000};
 
 // Main.Display
 
@@ -27,6 +27,9 @@ extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<bool> MAIN_LOAD_IPL_DUMP;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_PERSISTENT_CACHE;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+extern const Info<bool> MAIN_JIT_INTERPRET_COLD_BLOCKS;
 extern const Info<bool> MAIN_FASTMEM;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
@@ -90,6 +93,11 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+extern const Info<int> MAIN_STATE_COMPRESSION_LEVEL;
+extern const Info<bool> MAIN_REWIND_ENABLE;
+extern const Info<int> MAIN_REWIND_INTERVAL;
+extern const Info<int> MAIN_REWIND_MEMORY_BUDGET;
+extern const Info<int> MAIN_REWIND_FRAME_BUDGET;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 
 // Main.DSP
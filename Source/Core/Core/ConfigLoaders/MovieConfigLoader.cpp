@@ -33,6 +33,10 @@ static void LoadFromDTM(Config::Layer* config_layer, Movie::DTMHeader* dtm)
   config_layer->Set(Config::MAIN_CPU_CORE, static_cast<PowerPC::CPUCore>(dtm->CPUCore));
   config_layer->Set(Config::MAIN_SYNC_GPU, dtm->bSyncGPU);
   config_layer->Set(Config::MAIN_GFX_BACKEND, dtm->videoBackend.data());
+  // These change where blocks start and end, which affects timing and would desync.
+  config_layer->Set(Config::MAIN_JIT_PERSISTENT_CACHE, false);
+  config_layer->Set(Config::MAIN_JIT_TIERED_COMPILATION, false);
+  config_layer->Set(Config::MAIN_JIT_INTERPRET_COLD_BLOCKS, false);
 
   config_layer->Set(Config::SYSCONF_PROGRESSIVE_SCAN, dtm->bProgressive);
   config_layer->Set(Config::SYSCONF_PAL60, dtm->bPAL60);
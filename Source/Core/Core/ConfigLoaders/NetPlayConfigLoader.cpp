@@ -43,6 +43,12 @@ public:
     layer->Set(Config::MAIN_MEM2_SIZE, m_settings.m_Mem2Size);
     layer->Set(Config::MAIN_FALLBACK_REGION, m_settings.m_FallbackRegion);
     layer->Set(Config::MAIN_DSP_JIT, m_settings.m_DSPEnableJIT);
+    // These change where blocks start and end, which affects timing and would desync.
+    layer->Set(Config::MAIN_JIT_PERSISTENT_CACHE, false);
+    layer->Set(Config::MAIN_JIT_TIERED_COMPILATION, false);
+    layer->Set(Config::MAIN_JIT_INTERPRET_COLD_BLOCKS, false);
+    // Loading states is disabled in netplay, so there is no point in capturing them.
+    layer->Set(Config::MAIN_REWIND_ENABLE, false);
 
     for (size_t i = 0; i < Config::SYSCONF_SETTINGS.size(); ++i)
     {
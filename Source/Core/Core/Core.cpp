@@ -38,6 +38,7 @@
 
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
@@ -51,6 +52,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -63,6 +65,7 @@
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
 #include "Core/WiiRoot.h"
 
@@ -344,8 +347,13 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   static_cast<void>(IDCache::GetEnvForThread());
 #endif
 
-  if (_CoreParameter.bFastmem)
+  // Write tracking catches the first write to a page through the same handler as fastmem, and
+  // those writes can come from any thread.
+  const bool track_writes =
+      Config::Get(Config::GFX_TEXTURE_CACHE_WRITE_TRACKING) && EMM::HandlesAllThreads();
+  if (_CoreParameter.bFastmem || track_writes)
     EMM::InstallExceptionHandler();  // Let's run under memory watch
+  Memory::SetWriteTrackingEnabled(track_writes);
 
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher = std::make_unique<MemoryWatcher>();
@@ -387,7 +395,8 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
 
   s_is_started = false;
 
-  if (_CoreParameter.bFastmem)
+  Memory::SetWriteTrackingEnabled(false);
+  if (_CoreParameter.bFastmem || track_writes)
     EMM::UninstallExceptionHandler();
 }
 
@@ -888,6 +897,8 @@ void Callback_FramePresented(double actual_emulation_speed)
 // Called from VideoInterface::Update (CPU thread) at emulated field boundaries
 void Callback_NewField()
 {
+  Rewind::OnNewField();
+
   if (s_frame_step)
   {
     // To ensure that s_stop_frame_step is up to date, wait for the GPU thread queue to empty,
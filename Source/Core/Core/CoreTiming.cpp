@@ -5,7 +5,7 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -15,7 +15,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -26,10 +26,14 @@
 
 namespace CoreTiming
 {
+struct EventNode;
+
 struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  // Pending events of this type, so that they can be removed without searching the whole queue.
+  EventNode* pending;
 };
 
 struct Event
@@ -41,28 +45,222 @@ struct Event
 };
 
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
 static bool operator<(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
 }
 
+struct EventNode
+{
+  Event event;
+  // Heap links. prev points to the parent for the first child, and to the previous sibling
+  // for all other children.
+  EventNode* child;
+  EventNode* next;
+  EventNode* prev;
+  // Links in the list of pending events of the same type.
+  EventNode* type_next;
+  EventNode* type_prev;
+};
+
+namespace
+{
+// A pairing heap of events. Scheduling an event is O(1), popping the next event is O(log n)
+// amortized, and so is removing an event, which only needs to visit events of the removed type.
+// Nodes are recycled, so scheduling doesn't allocate once the queue has reached its usual size.
+class EventQueue
+{
+public:
+  bool Empty() const { return m_root == nullptr; }
+  const Event& Top() const { return m_root->event; }
+
+  void Push(const Event& event)
+  {
+    EventNode* node = AllocateNode();
+    node->event = event;
+    node->child = nullptr;
+    node->next = nullptr;
+    node->prev = nullptr;
+
+    EventType* type = event.type;
+    node->type_prev = nullptr;
+    node->type_next = type->pending;
+    if (type->pending)
+      type->pending->type_prev = node;
+    type->pending = node;
+
+    m_root = Meld(m_root, node);
+  }
+
+  Event Pop()
+  {
+    EventNode* node = m_root;
+    m_root = MergePairs(node->child);
+    UnlinkFromType(node);
+    const Event event = node->event;
+    m_free_nodes.push_back(node);
+    return event;
+  }
+
+  // Removes all pending events of the given type.
+  void Remove(EventType* type)
+  {
+    // PowerPC::Reset removes the decrementer event before SystemTimers has registered it.
+    if (!type)
+      return;
+
+    while (EventNode* node = type->pending)
+    {
+      UnlinkFromHeap(node);
+      UnlinkFromType(node);
+      m_free_nodes.push_back(node);
+    }
+  }
+
+  void Clear()
+  {
+    for (EventNode* node : GetNodes())
+    {
+      node->event.type->pending = nullptr;
+      m_free_nodes.push_back(node);
+    }
+    m_root = nullptr;
+  }
+
+  // Returns the pending events, sorted by the order they will run in.
+  std::vector<Event> GetEvents() const
+  {
+    std::vector<Event> events;
+    for (const EventNode* node : GetNodes())
+      events.push_back(node->event);
+    std::sort(events.begin(), events.end());
+    return events;
+  }
+
+  // Calls func on every pending event, which may change the event's time.
+  template <typename Func>
+  void AdjustEvents(Func func)
+  {
+    const std::vector<EventNode*> nodes = GetNodes();
+    m_root = nullptr;
+    for (EventNode* node : nodes)
+    {
+      func(node->event);
+      node->child = nullptr;
+      node->next = nullptr;
+      node->prev = nullptr;
+      m_root = Meld(m_root, node);
+    }
+  }
+
+private:
+  EventNode* AllocateNode()
+  {
+    if (m_free_nodes.empty())
+      return m_nodes.emplace_back(std::make_unique<EventNode>()).get();
+
+    EventNode* node = m_free_nodes.back();
+    m_free_nodes.pop_back();
+    return node;
+  }
+
+  std::vector<EventNode*> GetNodes() const
+  {
+    std::vector<EventNode*> nodes;
+    if (m_root)
+      nodes.push_back(m_root);
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      for (EventNode* child = nodes[i]->child; child; child = child->next)
+        nodes.push_back(child);
+    }
+    return nodes;
+  }
+
+  // Both arguments must be roots. Returns the new root.
+  static EventNode* Meld(EventNode* a, EventNode* b)
+  {
+    if (!a)
+      return b;
+    if (!b)
+      return a;
+    if (b->event < a->event)
+      std::swap(a, b);
+
+    b->prev = a;
+    b->next = a->child;
+    if (a->child)
+      a->child->prev = b;
+    a->child = b;
+    return a;
+  }
+
+  // Melds a list of siblings into a single heap using the standard two-pass method.
+  EventNode* MergePairs(EventNode* first)
+  {
+    m_merge_scratch.clear();
+    while (first)
+    {
+      EventNode* a = first;
+      EventNode* b = a->next;
+      first = b ? b->next : nullptr;
+      a->next = a->prev = nullptr;
+      if (b)
+        b->next = b->prev = nullptr;
+      m_merge_scratch.push_back(Meld(a, b));
+    }
+
+    EventNode* root = nullptr;
+    for (auto it = m_merge_scratch.rbegin(); it != m_merge_scratch.rend(); ++it)
+      root = Meld(*it, root);
+    return root;
+  }
+
+  void UnlinkFromHeap(EventNode* node)
+  {
+    if (node == m_root)
+    {
+      m_root = MergePairs(node->child);
+      return;
+    }
+
+    if (node->prev->child == node)
+      node->prev->child = node->next;
+    else
+      node->prev->next = node->next;
+    if (node->next)
+      node->next->prev = node->prev;
+
+    m_root = Meld(m_root, MergePairs(node->child));
+  }
+
+  static void UnlinkFromType(EventNode* node)
+  {
+    if (node->type_prev)
+      node->type_prev->type_next = node->type_next;
+    else
+      node->event.type->pending = node->type_next;
+    if (node->type_next)
+      node->type_next->type_prev = node->type_prev;
+  }
+
+  EventNode* m_root = nullptr;
+  std::vector<std::unique_ptr<EventNode>> m_nodes;
+  std::vector<EventNode*> m_free_nodes;
+  std::vector<EventNode*> m_merge_scratch;
+};
+}  // Anonymous namespace
+
 // unordered_map stores each element separately as a linked list node so pointers to elements
 // remain stable regardless of rehashes/resizing.
 static std::unordered_map<std::string, EventType> s_event_types;
 
 // STATE_TO_SAVE
-// The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-// We don't use std::priority_queue because we need to be able to serialize, unserialize and
-// erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-// by the standard adaptor class.
-static std::vector<Event> s_event_queue;
+static EventQueue s_event_queue;
 static u64 s_event_fifo_id;
-static std::mutex s_ts_write_lock;
-static Common::SPSCQueue<Event, false> s_ts_queue;
+// Events scheduled from threads other than the CPU thread, which are moved into s_event_queue on
+// the CPU thread.
+static Common::MPSCQueue<Event> s_ts_queue;
 
 static float s_last_OC_factor;
 static constexpr int MAX_SLICE_LENGTH = 20000;
@@ -108,7 +306,7 @@ EventType* RegisterEvent(const std::string& name, TimedCallback callback)
              "during Init to avoid breaking save states.",
              name.c_str());
 
-  auto info = s_event_types.emplace(name, EventType{callback, nullptr});
+  auto info = s_event_types.emplace(name, EventType{callback, nullptr, nullptr});
   EventType* event_type = &info.first->second;
   event_type->name = &info.first->first;
   return event_type;
@@ -116,7 +314,7 @@ EventType* RegisterEvent(const std::string& name, TimedCallback callback)
 
 void UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, s_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, s_event_queue.Empty(), "Cannot unregister events with events pending");
   s_event_types.clear();
 }
 
@@ -141,7 +339,6 @@ void Init()
 
 void Shutdown()
 {
-  std::lock_guard lk(s_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -149,7 +346,6 @@ void Shutdown()
 
 void DoState(PointerWrap& p)
 {
-  std::lock_guard lk(s_ts_write_lock);
   p.Do(g.slice_length);
   p.Do(g.global_timer);
   p.Do(s_idled_cycles);
@@ -164,7 +360,10 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(s_event_queue, [](PointerWrap& pw, Event& ev) {
+  std::vector<Event> events;
+  if (p.GetMode() != PointerWrap::MODE_READ)
+    events = s_event_queue.GetEvents();
+  p.DoEachElement(events, [](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -198,10 +397,13 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingEvents");
 
   // When loading from a save state, we must assume the Event order is random and meaningless.
-  // The exact layout of the heap in memory is implementation defined, therefore it is platform
-  // and library version specific.
+  // Older versions saved the memory layout of a binary heap, which is implementation defined.
   if (p.GetMode() == PointerWrap::MODE_READ)
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+  {
+    s_event_queue.Clear();
+    for (const Event& ev : events)
+      s_event_queue.Push(ev);
+  }
 }
 
 // This should only be called from the CPU thread. If you are calling
@@ -224,7 +426,7 @@ u64 GetIdleTicks()
 
 void ClearPendingEvents()
 {
-  s_event_queue.clear();
+  s_event_queue.Clear();
 }
 
 void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata, FromThread from)
@@ -252,8 +454,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     if (!s_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    s_event_queue.emplace_back(Event{timeout, s_event_fifo_id++, userdata, event_type});
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    s_event_queue.Push(Event{timeout, s_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -265,22 +466,13 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
                     *event_type->name);
     }
 
-    std::lock_guard lk(s_ts_write_lock);
     s_ts_queue.Push(Event{g.global_timer + cycles_into_future, 0, userdata, event_type});
   }
 }
 
 void RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(s_event_queue.begin(), s_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != s_event_queue.end())
-  {
-    s_event_queue.erase(itr, s_event_queue.end());
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-  }
+  s_event_queue.Remove(event_type);
 }
 
 void RemoveAllEvents(EventType* event_type)
@@ -306,8 +498,7 @@ void MoveEvents()
   for (Event ev; s_ts_queue.Pop(ev);)
   {
     ev.fifo_order = s_event_fifo_id++;
-    s_event_queue.emplace_back(std::move(ev));
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    s_event_queue.Push(ev);
   }
 }
 
@@ -323,21 +514,19 @@ void Advance()
 
   s_is_global_timer_sane = true;
 
-  while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer)
+  while (!s_event_queue.Empty() && s_event_queue.Top().time <= g.global_timer)
   {
-    Event evt = std::move(s_event_queue.front());
-    std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-    s_event_queue.pop_back();
+    const Event evt = s_event_queue.Pop();
     evt.type->callback(evt.userdata, g.global_timer - evt.time);
   }
 
   s_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!s_event_queue.empty())
+  if (!s_event_queue.Empty())
   {
     g.slice_length = static_cast<int>(
-        std::min<s64>(s_event_queue.front().time - g.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(s_event_queue.Top().time - g.global_timer, MAX_SLICE_LENGTH));
   }
 
   PowerPC::ppcState.downcount = CyclesToDowncount(g.slice_length);
@@ -351,9 +540,7 @@ void Advance()
 
 void LogPendingEvents()
 {
-  auto clone = s_event_queue;
-  std::sort(clone.begin(), clone.end());
-  for (const Event& ev : clone)
+  for (const Event& ev : s_event_queue.GetEvents())
   {
     INFO_LOG_FMT(POWERPC, "PENDING: Now: {} Pending: {} Type: {}", g.global_timer, ev.time,
                  *ev.type->name);
@@ -363,11 +550,10 @@ void LogPendingEvents()
 // Should only be called from the CPU thread after the PPC clock has changed
 void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock)
 {
-  for (Event& ev : s_event_queue)
-  {
+  s_event_queue.AdjustEvents([=](Event& ev) {
     const s64 ticks = (ev.time - g.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = g.global_timer + ticks;
-  }
+  });
 }
 
 void Idle()
@@ -390,9 +576,7 @@ std::string GetScheduledEventsSummary()
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = s_event_queue;
-  std::sort(clone.begin(), clone.end());
-  for (const Event& ev : clone)
+  for (const Event& ev : s_event_queue.GetEvents())
   {
     text += fmt::format("{} : {} {:016x}\n", *ev.type->name, ev.time, ev.userdata);
   }
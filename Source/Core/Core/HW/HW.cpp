@@ -24,6 +24,7 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
 #include "Core/IOS/IOS.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
 
 namespace HW
@@ -34,6 +35,7 @@ void Init()
   SystemTimers::PreInit();
 
   State::Init();
+  Rewind::Init();
 
   // Init the whole Hardware
   AudioInterface::Init();
@@ -72,6 +74,7 @@ void Shutdown()
   SerialInterface::Shutdown();
   AudioInterface::Shutdown();
 
+  Rewind::Shutdown();
   State::Shutdown();
   CoreTiming::Shutdown();
 }
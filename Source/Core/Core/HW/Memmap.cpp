@@ -11,13 +11,19 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -182,6 +188,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
 };
 
 // Dolphin allocates memory to represent four regions:
@@ -228,6 +235,132 @@ static std::array<PhysicalMemoryRegion, 4> s_physical_regions;
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+// Write tracking state. Page indices count the pages of RAM first, followed by those of EXRAM.
+// Everything except the write epochs is guarded by the mutex. The fault handler can't take the
+// mutex, so it only marks pages in the write epochs, and TrackWrites drains those marks later.
+static std::atomic<bool> s_write_tracking_enabled{false};
+static std::atomic<bool> s_write_tracking_initialized{false};
+static std::mutex s_write_tracking_mutex;
+static u32 s_write_tracking_page_size;
+static u64 s_write_tracking_epoch;
+static std::unique_ptr<std::atomic<u64>[]> s_page_write_epochs;
+static std::vector<bool> s_page_protected;
+
+// Written by the fault handler. Pages with this epoch may be writable through some of their views
+// while s_page_protected still says otherwise.
+constexpr u64 WRITE_FAULT_EPOCH = std::numeric_limits<u64>::max();
+
+// Copies of the fastmem mappings for the fault handler, which can run on any thread while the CPU
+// thread changes the mappings. They are written under the mutex. Each entry of the logical pages
+// holds the physical address the BAT page is mapped to, or 0 if it isn't mapped.
+static std::atomic<u8*> s_fault_physical_base{nullptr};
+static std::atomic<u8*> s_fault_logical_base{nullptr};
+static std::array<std::atomic<u32>, std::tuple_size_v<PowerPC::BatTable>> s_fault_logical_pages;
+
+static void ClearFaultLogicalPages()
+{
+  for (std::atomic<u32>& page : s_fault_logical_pages)
+    page.store(0, std::memory_order_relaxed);
+}
+
+template <typename Function>
+static void ForEachTrackedView(Function function)
+{
+  for (const PhysicalMemoryRegion* region : {&s_physical_regions[0], &s_physical_regions[3]})
+  {
+    if (!region->active)
+      continue;
+
+    function(*region->out_pointer, region->physical_address, region->size);
+    if (is_fastmem_arena_initialized)
+      function(physical_base + region->physical_address, region->physical_address, region->size);
+  }
+
+  for (const LogicalMemoryView& view : logical_mapped_entries)
+    function(static_cast<u8*>(view.mapped_pointer), view.physical_address, view.mapped_size);
+}
+
+static std::optional<u32> GetTrackedPage(u32 physical_address)
+{
+  if (physical_address < GetRamSize())
+    return physical_address / s_write_tracking_page_size;
+
+  const u32 exram_address = physical_address - s_physical_regions[3].physical_address;
+  if (s_physical_regions[3].active && exram_address < GetExRamSize())
+    return (GetRamSize() + exram_address) / s_write_tracking_page_size;
+
+  return std::nullopt;
+}
+
+static u32 GetTrackedPageAddress(u32 page)
+{
+  const u32 offset = page * s_write_tracking_page_size;
+  if (offset < GetRamSize())
+    return offset;
+
+  return s_physical_regions[3].physical_address + offset - GetRamSize();
+}
+
+static void SetPagesProtected(u32 first_page, u32 num_pages, bool is_protected)
+{
+  const u32 start = GetTrackedPageAddress(first_page);
+  const u32 end = start + num_pages * s_write_tracking_page_size;
+  ForEachTrackedView([&](u8* view, u32 view_address, u32 view_size) {
+    const u32 protect_start = std::max(start, view_address);
+    const u32 protect_end = std::min(end, view_address + view_size);
+    if (protect_start >= protect_end)
+      return;
+
+    u8* pointer = view + (protect_start - view_address);
+    if (is_protected)
+      Common::WriteProtectMemory(pointer, protect_end - protect_start);
+    else
+      Common::UnWriteProtectMemory(pointer, protect_end - protect_start);
+  });
+
+  for (u32 page = first_page; page < first_page + num_pages; page++)
+    s_page_protected[page] = is_protected;
+}
+
+// Changes the protection of all pages in the range which don't have it yet, a run at a time.
+static void UpdatePageProtection(u32 first_page, u32 end_page, bool is_protected)
+{
+  u32 run_start = first_page;
+  for (u32 page = first_page; page <= end_page; page++)
+  {
+    if (page < end_page && s_page_protected[page] != is_protected)
+      continue;
+
+    if (run_start != page)
+      SetPagesProtected(run_start, page - run_start, is_protected);
+    run_start = page + 1;
+  }
+}
+
+// Marks every tracked page as written. Must be called with the mutex held.
+static void UnprotectAllTrackedPages()
+{
+  if (!s_write_tracking_initialized)
+    return;
+
+  const u32 num_pages = static_cast<u32>(s_page_protected.size());
+  const u64 epoch = ++s_write_tracking_epoch;
+  for (u32 page = 0; page < num_pages; page++)
+    s_page_write_epochs[page].store(epoch, std::memory_order_relaxed);
+
+  UpdatePageProtection(0, num_pages, false);
+}
+
+static void ShutdownWriteTracking()
+{
+  SetWriteTrackingEnabled(false);
+
+  std::lock_guard guard(s_write_tracking_mutex);
+  s_write_tracking_initialized = false;
+  s_page_write_epochs.reset();
+  s_page_protected.clear();
+}
+
 void Init()
 {
   const auto get_mem1_size = [] {
@@ -315,6 +448,9 @@ void Init()
 
 bool InitFastmemArena()
 {
+  std::lock_guard guard(s_write_tracking_mutex);
+  UnprotectAllTrackedPages();
+
   physical_base = Common::MemArena::FindMemoryBase();
 
   if (!physical_base)
@@ -344,6 +480,8 @@ bool InitFastmemArena()
   logical_base = physical_base + 0x200000000;
 #endif
 
+  s_fault_physical_base.store(physical_base, std::memory_order_release);
+  s_fault_logical_base.store(logical_base, std::memory_order_release);
   is_fastmem_arena_initialized = true;
   return true;
 }
@@ -353,11 +491,16 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   if (!is_fastmem_arena_initialized)
     return;
 
+  // The new views won't be write-protected, so the tracked pages have to start over.
+  std::lock_guard guard(s_write_tracking_mutex);
+  UnprotectAllTrackedPages();
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
   }
   logical_mapped_entries.clear();
+  ClearFaultLogicalPages();
   for (u32 i = 0; i < dbat_table.size(); ++i)
   {
     if (dbat_table[i] & PowerPC::BAT_PHYSICAL_BIT)
@@ -390,7 +533,9 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                           intersection_start, mapped_size, logical_address);
             exit(0);
           }
-          logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+          logical_mapped_entries.push_back({mapped_pointer, mapped_size, intersection_start});
+          s_fault_logical_pages[i].store(translated_address | PowerPC::BAT_PHYSICAL_BIT,
+                                         std::memory_order_release);
         }
       }
     }
@@ -400,6 +545,12 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 void DoState(PointerWrap& p)
 {
   bool wii = SConfig::GetInstance().bWii;
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    std::lock_guard guard(s_write_tracking_mutex);
+    UnprotectAllTrackedPages();
+  }
+
   p.DoArray(m_pRAM, GetRamSize());
   p.DoArray(m_pL1Cache, GetL1CacheSize());
   p.DoMarker("Memory RAM");
@@ -413,6 +564,7 @@ void DoState(PointerWrap& p)
 
 void Shutdown()
 {
+  ShutdownWriteTracking();
   ShutdownFastmemArena();
 
   m_IsInitialized = false;
@@ -434,6 +586,9 @@ void ShutdownFastmemArena()
   if (!is_fastmem_arena_initialized)
     return;
 
+  std::lock_guard guard(s_write_tracking_mutex);
+  UnprotectAllTrackedPages();
+
   for (const PhysicalMemoryRegion& region : s_physical_regions)
   {
     if (!region.active)
@@ -448,13 +603,157 @@ void ShutdownFastmemArena()
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
   }
   logical_mapped_entries.clear();
+  ClearFaultLogicalPages();
 
+  s_fault_physical_base.store(nullptr, std::memory_order_release);
+  s_fault_logical_base.store(nullptr, std::memory_order_release);
   physical_base = nullptr;
   logical_base = nullptr;
 
   is_fastmem_arena_initialized = false;
 }
 
+void SetWriteTrackingEnabled(bool enabled)
+{
+  std::lock_guard guard(s_write_tracking_mutex);
+  if (enabled && !s_write_tracking_initialized)
+  {
+    s_write_tracking_page_size = static_cast<u32>(Common::MemPageSize());
+    const u32 tracked_size = GetRamSize() + (s_physical_regions[3].active ? GetExRamSize() : 0);
+    const u32 num_pages = tracked_size / s_write_tracking_page_size;
+    s_write_tracking_epoch = 1;
+    s_page_write_epochs = std::make_unique<std::atomic<u64>[]>(num_pages);
+    for (u32 page = 0; page < num_pages; page++)
+      s_page_write_epochs[page].store(0, std::memory_order_relaxed);
+    s_page_protected.assign(num_pages, false);
+    s_write_tracking_initialized = true;
+  }
+  else if (!enabled)
+  {
+    UnprotectAllTrackedPages();
+  }
+
+  s_write_tracking_enabled = enabled;
+}
+
+bool IsWriteTrackingEnabled()
+{
+  return s_write_tracking_enabled.load(std::memory_order_relaxed);
+}
+
+u64 TrackWrites(u32 address, u32 size)
+{
+  if (!IsWriteTrackingEnabled() || size == 0)
+    return 0;
+
+  address &= 0x3FFFFFFF;
+  const std::optional<u32> first_page = GetTrackedPage(address);
+  const std::optional<u32> last_page = GetTrackedPage(address + size - 1);
+  if (!first_page || !last_page || *last_page < *first_page)
+    return 0;
+
+  std::lock_guard guard(s_write_tracking_mutex);
+  if (!s_write_tracking_enabled)
+    return 0;
+
+  for (u32 page = *first_page; page <= *last_page; page++)
+  {
+    if (s_page_write_epochs[page].load(std::memory_order_acquire) != WRITE_FAULT_EPOCH)
+      continue;
+
+    // If the fault handler marks the page again after this, it has unprotected the page before,
+    // and the protection below still applies.
+    s_page_write_epochs[page].store(s_write_tracking_epoch, std::memory_order_release);
+    s_page_protected[page] = false;
+  }
+
+  // Writes that happen after this point either fault and mark their page, or are seen by the
+  // caller when it reads the data.
+  const u64 token = ++s_write_tracking_epoch;
+  UpdatePageProtection(*first_page, *last_page + 1, true);
+  return token;
+}
+
+bool WrittenSince(u32 address, u32 size, u64 token)
+{
+  if (!IsWriteTrackingEnabled() || token == 0)
+    return true;
+
+  address &= 0x3FFFFFFF;
+  const std::optional<u32> first_page = GetTrackedPage(address);
+  const std::optional<u32> last_page = GetTrackedPage(address + size - 1);
+  if (!first_page || !last_page)
+    return true;
+
+  for (u32 page = *first_page; page <= *last_page; page++)
+  {
+    if (s_page_write_epochs[page].load(std::memory_order_acquire) >= token)
+      return true;
+  }
+  return false;
+}
+
+// Only reads the atomic copies of the fastmem mappings, since faults can happen on any thread.
+static std::optional<u32> GetFaultPhysicalAddress(uintptr_t fault_address)
+{
+  const auto in_view = [fault_address](const u8* view, u64 view_size) {
+    const uintptr_t view_start = reinterpret_cast<uintptr_t>(view);
+    return view && fault_address >= view_start && fault_address - view_start < view_size;
+  };
+  const auto offset = [fault_address](const u8* view) {
+    return static_cast<u32>(fault_address - reinterpret_cast<uintptr_t>(view));
+  };
+
+  for (const PhysicalMemoryRegion* region : {&s_physical_regions[0], &s_physical_regions[3]})
+  {
+    if (region->active && in_view(*region->out_pointer, region->size))
+      return region->physical_address + offset(*region->out_pointer);
+  }
+
+  const u8* fault_physical_base = s_fault_physical_base.load(std::memory_order_acquire);
+  if (in_view(fault_physical_base, 0x100000000))
+    return offset(fault_physical_base);
+
+  const u8* fault_logical_base = s_fault_logical_base.load(std::memory_order_acquire);
+  if (!in_view(fault_logical_base, 0x100000000))
+    return std::nullopt;
+
+  const u32 logical_address = offset(fault_logical_base);
+  const u32 entry = s_fault_logical_pages[logical_address >> PowerPC::BAT_INDEX_SHIFT].load(
+      std::memory_order_acquire);
+  if (!(entry & PowerPC::BAT_PHYSICAL_BIT))
+    return std::nullopt;
+
+  return (entry & PowerPC::BAT_RESULT_MASK) + (logical_address & (PowerPC::BAT_PAGE_SIZE - 1));
+}
+
+bool HandleWriteFault(uintptr_t fault_address)
+{
+  // This runs in the fault handler, where taking the mutex could deadlock if the faulting thread
+  // already holds it. Only the write epochs and the page protection are changed here.
+  if (!s_write_tracking_initialized)
+    return false;
+
+  const std::optional<u32> physical_address = GetFaultPhysicalAddress(fault_address);
+  if (!physical_address)
+    return false;
+
+  const std::optional<u32> page = GetTrackedPage(*physical_address);
+  if (!page)
+    return false;
+
+  // Only the faulting view is unprotected. Writes through the other views of the page fault as
+  // well, until TrackWrites drains the mark and updates the protection of all views. The page is
+  // marked again afterwards, in case TrackWrites drained the first mark before the page was
+  // unprotected here.
+  const uintptr_t page_mask = ~static_cast<uintptr_t>(s_write_tracking_page_size - 1);
+  s_page_write_epochs[*page].store(WRITE_FAULT_EPOCH, std::memory_order_release);
+  Common::UnWriteProtectMemory(reinterpret_cast<void*>(fault_address & page_mask),
+                               s_write_tracking_page_size);
+  s_page_write_epochs[*page].store(WRITE_FAULT_EPOCH, std::memory_order_release);
+  return true;
+}
+
 void Clear()
 {
   if (m_pRAM)
@@ -558,6 +857,22 @@ u8* GetPointer(u32 address)
   return nullptr;
 }
 
+u8* TryGetPointerForRange(u32 address, size_t size)
+{
+  address &= 0x3FFFFFFF;
+  if (address < GetRamSizeReal())
+    return size <= GetRamSizeReal() - address ? m_pRAM + address : nullptr;
+
+  if (m_pEXRAM && (address >> 28) == 0x1)
+  {
+    const u32 offset = address & 0x0fffffff;
+    if (offset < GetExRamSizeReal() && size <= GetExRamSizeReal() - offset)
+      return m_pEXRAM + (address & GetExRamMask());
+  }
+
+  return nullptr;
+}
+
 u8 Read_U8(u32 address)
 {
   return *GetPointer(address);
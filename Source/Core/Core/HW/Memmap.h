@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -71,10 +72,25 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
 void Clear();
 
+// Write tracking lets the texture cache skip rehashing textures whose memory hasn't changed. While
+// it is enabled, tracked pages of RAM are write-protected, and the first write to one of them is
+// recorded by the fault handler, which then makes the page writable again. The fault handler has to
+// be installed whenever write tracking is enabled.
+void SetWriteTrackingEnabled(bool enabled);
+bool IsWriteTrackingEnabled();
+// Starts tracking writes to the given range. The returned token stays valid for WrittenSince as
+// long as the data is read after the call. Returns 0 if the range can't be tracked.
+u64 TrackWrites(u32 address, u32 size);
+bool WrittenSince(u32 address, u32 size, u64 token);
+bool HandleWriteFault(uintptr_t fault_address);
+
 // Routines to access physically addressed memory, designed for use by
 // emulated hardware outside the CPU. Use "Device_" prefix.
 std::string GetString(u32 em_address, size_t size = 0);
 u8* GetPointer(u32 address);
+// Returns a pointer to the given range if all of it is in RAM or EXRAM. Unlike GetPointer, this
+// returns nullptr instead of raising a panic alert if it isn't.
+u8* TryGetPointerForRange(u32 address, size_t size);
 void CopyFromEmu(void* data, u32 address, size_t size);
 void CopyToEmu(u32 address, const void* data, size_t size);
 void Memset(u32 address, u8 value, size_t size);
@@ -3,7 +3,9 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
@@ -129,11 +131,17 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 
   // File might be opened twice, need to seek before we read
   handle->host_file->Seek(handle->file_offset, SEEK_SET);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
+  // ptr usually points to emulated RAM, which fread can't write to directly while it is
+  // write-protected for write tracking.
+  std::vector<u8> buffer(count);
+  const u32 actually_read =
+      static_cast<u32>(fread(buffer.data(), 1, count, handle->host_file->GetHandle()));
 
   if (actually_read != count && ferror(handle->host_file->GetHandle()))
     return ResultCode::AccessDenied;
 
+  std::memcpy(ptr, buffer.data(), actually_read);
+
   // IOS returns the number of bytes read and adds that value to the seek position,
   // instead of adding the *requested* read length.
   handle->file_offset += actually_read;
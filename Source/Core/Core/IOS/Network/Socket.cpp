@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <vector>
 
 #include <mbedtls/error.h>
 #ifndef _WIN32
@@ -619,11 +620,16 @@ void WiiSocket::Update(bool read, bool write, bool except)
           socklen_t addrlen = sizeof(sockaddr_in);
           auto* from = BufferOutSize2 ? reinterpret_cast<sockaddr*>(&local_name) : nullptr;
           socklen_t* fromlen = BufferOutSize2 ? &addrlen : nullptr;
-          const int ret = recvfrom(fd, data, data_len, flags, from, fromlen);
+          // The system call can't write to emulated RAM while it is write-protected.
+          std::vector<char> buffer(data_len);
+          const int ret = recvfrom(fd, buffer.data(), data_len, flags, from, fromlen);
           ReturnValue =
               WiiSockMan::GetNetErrorCode(ret, BufferOutSize2 ? "SO_RECVFROM" : "SO_RECV", true);
           if (ret > 0)
+          {
+            Memory::CopyToEmu(BufferOut, buffer.data(), ret);
             PowerPC::debug_interface.NetworkLogger()->LogRead(data, ret, fd, from);
+          }
 
           INFO_LOG_FMT(IOS_NET,
                        "{}({}, {}) Socket: {:08X}, Flags: {:08X}, "
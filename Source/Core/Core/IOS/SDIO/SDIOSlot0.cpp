@@ -255,8 +255,10 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
       if (!m_card.Seek(address, SEEK_SET))
         ERROR_LOG_FMT(IOS_SD, "Seek failed WTF");
 
-      if (m_card.ReadBytes(Memory::GetPointer(req.addr), size))
+      std::vector<u8> buffer(size);
+      if (m_card.ReadBytes(buffer.data(), size))
       {
+        Memory::CopyToEmu(req.addr, buffer.data(), size);
         DEBUG_LOG_FMT(IOS_SD, "Outbuffer size {} got {}", rw_buffer_size, size);
       }
       else
@@ -514,7 +514,9 @@ std::optional<IPCReply> WFSIDevice::IOCtl(const IOCtlRequest& request)
     }
     else
     {
-      fp.ReadBytes(Memory::GetPointer(dol_addr), max_dol_size);
+      std::vector<u8> buffer(max_dol_size);
+      fp.ReadBytes(buffer.data(), max_dol_size);
+      Memory::CopyToEmu(dol_addr, buffer.data(), max_dol_size);
     }
     Memory::Write_U32(real_dol_size, request.buffer_out);
     break;
@@ -561,7 +563,9 @@ u32 WFSIDevice::GetTmd(u16 group_id, u32 title_id, u64 subtitle_id, u32 address,
   }
   if (address)
   {
-    fp.ReadBytes(Memory::GetPointer(address), fp.GetSize());
+    std::vector<u8> buffer(fp.GetSize());
+    fp.ReadBytes(buffer.data(), buffer.size());
+    Memory::CopyToEmu(address, buffer.data(), buffer.size());
   }
   *size = fp.GetSize();
   return IPC_SUCCESS;
@@ -295,7 +295,9 @@ std::optional<IPCReply> WFSSRVDevice::IOCtl(const IOCtlRequest& request)
       fd_obj->file.Seek(position, SEEK_SET);
     }
     size_t read_bytes;
-    fd_obj->file.ReadArray(Memory::GetPointer(addr), size, &read_bytes);
+    std::vector<u8> buffer(size);
+    fd_obj->file.ReadArray(buffer.data(), size, &read_bytes);
+    Memory::CopyToEmu(addr, buffer.data(), read_bytes);
     // TODO(wfs): Handle read errors.
     if (absolute)
     {
@@ -17,6 +17,8 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Executes instructions up to and including the next branch. Returns the number of cycles taken.
+  int RunBlock();
 
   void Run() override;
   void ClearCache() override;
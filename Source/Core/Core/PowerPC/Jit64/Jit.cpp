@@ -24,7 +24,9 @@
 #include "Common/PerformanceCounter.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Timer.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -34,6 +36,7 @@
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/MachineContext.h"
 #include "Core/PatchEngine.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/RegCache/JitRegCache.h"
 #include "Core/PowerPC/Jit64Common/FarCodeCache.h"
@@ -379,6 +382,20 @@ void Jit64::Init()
   EnableOptimization();
 
   ResetFreeMemoryRanges();
+
+  m_enable_tiering = Config::Get(Config::MAIN_JIT_TIERED_COMPILATION) &&
+                     !SConfig::GetInstance().bEnableDebugging;
+  m_interpret_cold_blocks = Config::Get(Config::MAIN_JIT_INTERPRET_COLD_BLOCKS) &&
+                            !SConfig::GetInstance().bEnableDebugging;
+  m_cold_block_runs.clear();
+  m_branch_profile.clear();
+  analyzer.SetBranchProfile(&m_branch_profile);
+
+  // The game ID isn't known yet at this point, so the cache file is loaded on the first Jit call.
+  m_persistent_cache_enabled = Config::Get(Config::MAIN_JIT_PERSISTENT_CACHE) &&
+                               !SConfig::GetInstance().bEnableDebugging;
+  m_persistent_cache_game_id.clear();
+  m_persistent_cache.Clear();
 }
 
 void Jit64::ClearCache()
@@ -392,6 +409,8 @@ void Jit64::ClearCache()
   Clear();
   UpdateMemoryOptions();
   ResetFreeMemoryRanges();
+  m_cold_block_runs.clear();
+  m_branch_profile.clear();
 }
 
 void Jit64::ResetFreeMemoryRanges()
@@ -405,6 +424,10 @@ void Jit64::ResetFreeMemoryRanges()
 
 void Jit64::Shutdown()
 {
+  if (m_persistent_cache_enabled && !m_persistent_cache_game_id.empty())
+    m_persistent_cache.Save(JitPersistentCache::GetFilename(m_persistent_cache_game_id));
+  m_persistent_cache.Clear();
+
   FreeStack();
   FreeCodeSpace();
 
@@ -777,6 +800,15 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     m_free_ranges_far.insert(range.first, range.second);
   blocks.ClearRangesToFree();
 
+  if (m_persistent_cache_enabled && !SConfig::GetInstance().bJITNoBlockCache)
+    WarmUpFromPersistentCache(em_address);
+
+  if (m_interpret_cold_blocks && !SConfig::GetInstance().bJITNoBlockCache &&
+      InterpretColdBlock(em_address))
+  {
+    return;
+  }
+
   std::size_t block_size = m_code_buffer.size();
 
   if (SConfig::GetInstance().bEnableDebugging)
@@ -807,7 +839,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
-  const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  const u32 nextPC = AnalyzeBlock(em_address, block_size);
 
   if (code_block.m_memory_exception)
   {
@@ -819,35 +851,8 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
-  if (SetEmitterStateToFreeCodeRegion())
-  {
-    u8* near_start = GetWritableCodePtr();
-    u8* far_start = m_far_code.GetWritableCodePtr();
-
-    JitBlock* b = blocks.AllocateBlock(em_address);
-    if (DoJit(em_address, b, nextPC))
-    {
-      // Code generation succeeded.
-
-      // Mark the memory regions that this code block uses as used in the local rangesets.
-      u8* near_end = GetWritableCodePtr();
-      if (near_start != near_end)
-        m_free_ranges_near.erase(near_start, near_end);
-      u8* far_end = m_far_code.GetWritableCodePtr();
-      if (far_start != far_end)
-        m_free_ranges_far.erase(far_start, far_end);
-
-      // Store the used memory regions in the block so we know what to mark as unused when the
-      // block gets invalidated.
-      b->near_begin = near_start;
-      b->near_end = near_end;
-      b->far_begin = far_start;
-      b->far_end = far_end;
-
-      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
-      return;
-    }
-  }
+  if (CompileAnalyzedBlock(em_address, nextPC))
+    return;
 
   if (clear_cache_and_retry_on_failure)
   {
@@ -865,6 +870,161 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   std::exit(-1);
 }
 
+u32 Jit64::AnalyzeBlock(u32 em_address, std::size_t block_size)
+{
+  m_compiling_baseline_tier =
+      m_enable_tiering && js.hotBlockAddresses.find(em_address) == js.hotBlockAddresses.end();
+  if (!m_compiling_baseline_tier)
+  {
+    // Undo the restrictions of the previous block if it was compiled at the baseline tier.
+    if (m_enable_tiering)
+      EnableOptimization();
+    return analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  }
+
+  // The baseline tier skips branch following and the instruction reordering passes, which keeps
+  // blocks short and cheap to compile. The options stay cleared until the next block is analyzed,
+  // since the instructions check some of them while the block is compiled too.
+  analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_MERGE);
+  analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
+  analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
+  analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_FOLLOW_HOT_BRANCHES);
+  return analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+}
+
+bool Jit64::CompileAnalyzedBlock(u32 em_address, u32 nextPC)
+{
+  if (!SetEmitterStateToFreeCodeRegion())
+    return false;
+
+  u8* near_start = GetWritableCodePtr();
+  u8* far_start = m_far_code.GetWritableCodePtr();
+
+  JitBlock* b = blocks.AllocateBlock(em_address);
+  if (!DoJit(em_address, b, nextPC))
+    return false;
+
+  // Code generation succeeded.
+
+  // Mark the memory regions that this code block uses as used in the local rangesets.
+  u8* near_end = GetWritableCodePtr();
+  if (near_start != near_end)
+    m_free_ranges_near.erase(near_start, near_end);
+  u8* far_end = m_far_code.GetWritableCodePtr();
+  if (far_start != far_end)
+    m_free_ranges_far.erase(far_start, far_end);
+
+  // Store the used memory regions in the block so we know what to mark as unused when the
+  // block gets invalidated.
+  b->near_begin = near_start;
+  b->near_end = near_end;
+  b->far_begin = far_start;
+  b->far_end = far_end;
+
+  blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+
+  if (m_persistent_cache_enabled)
+    m_persistent_cache.RecordBlock(*b);
+
+  return true;
+}
+
+void Jit64::WarmUpFromPersistentCache(u32 em_address)
+{
+  std::vector<JitPersistentCache::Entry> entries;
+  bool defer_missing = false;
+  if (m_persistent_cache_game_id.empty())
+  {
+    m_persistent_cache_game_id = SConfig::GetInstance().GetGameID();
+    if (m_persistent_cache_game_id.empty())
+    {
+      m_persistent_cache_enabled = false;
+      return;
+    }
+
+    m_persistent_cache.Load(JitPersistentCache::GetFilename(m_persistent_cache_game_id));
+    entries = m_persistent_cache.TakeLoadedEntries();
+    // Code which hasn't been loaded yet (e.g. REL modules) gets another chance later on.
+    defer_missing = true;
+  }
+  else if (m_persistent_cache.HasDeferredEntries())
+  {
+    const auto translated = PowerPC::JitCache_TranslateAddress(em_address);
+    if (translated.valid)
+      entries = m_persistent_cache.TakeDeferredEntries(translated.address);
+  }
+
+  if (entries.empty())
+    return;
+
+  Common::Timer timer;
+  timer.Start();
+
+  size_t compiled = 0;
+  for (JitPersistentCache::Entry& entry : entries)
+  {
+    if (!JitPersistentCache::MatchesMemory(entry))
+    {
+      if (defer_missing)
+        m_persistent_cache.DeferEntry(std::move(entry));
+      continue;
+    }
+
+    if (!CompilePersistentCacheEntry(entry))
+    {
+      WARN_LOG_FMT(DYNA_REC, "Code regions are full, stopping JIT block cache warm-up");
+      break;
+    }
+    compiled++;
+  }
+
+  NOTICE_LOG_FMT(DYNA_REC, "Compiled {} of {} cached JIT blocks in {} ms", compiled,
+                 entries.size(), timer.GetTimeElapsed());
+}
+
+bool Jit64::CompilePersistentCacheEntry(const JitPersistentCache::Entry& entry)
+{
+  // The analyzer and the block cache both look at the current MSR for address translation,
+  // so temporarily switch to the translation mode the block was originally compiled in.
+  const u32 old_msr = MSR.Hex;
+  MSR.Hex = (old_msr & ~JitBaseBlockCache::JIT_CACHE_MSR_MASK) | entry.msr_bits;
+  UpdateMemoryOptions();
+
+  bool success = true;
+  const auto translated = PowerPC::JitCache_TranslateAddress(entry.effective_address);
+  if (translated.valid && translated.address == entry.physical_address &&
+      !blocks.GetBlockFromStartAddress(entry.effective_address, MSR.Hex))
+  {
+    const u32 nextPC = AnalyzeBlock(entry.effective_address, m_code_buffer.size());
+    if (!code_block.m_memory_exception && !CompileAnalyzedBlock(entry.effective_address, nextPC))
+    {
+      // The failed block was already allocated, so the cache has to be reset before the
+      // regular compilation path can continue.
+      ClearCache();
+      success = false;
+    }
+  }
+
+  MSR.Hex = old_msr;
+  UpdateMemoryOptions();
+  return success;
+}
+
+bool Jit64::InterpretColdBlock(u32 em_address)
+{
+  u32& runs = m_cold_block_runs[em_address];
+  if (runs >= COLD_BLOCK_THRESHOLD)
+    return false;
+  runs++;
+
+  // Code which only runs a few times, like initialization code or code which is about to be
+  // overwritten, is cheaper to interpret than to compile. The dispatcher checks the downcount
+  // after returning from here, so interpreting can't delay CoreTiming events.
+  PowerPC::ppcState.downcount -= Interpreter::getInstance()->RunBlock();
+  return true;
+}
+
 bool Jit64::SetEmitterStateToFreeCodeRegion()
 {
   // Find the largest free memory blocks and set code emitters to point at them.
@@ -922,6 +1082,25 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+  // Count down the runs of baseline tier blocks, and have them recompiled once they're hot.
+  if (m_compiling_baseline_tier)
+  {
+    b->tier_up_countdown = TIER_UP_THRESHOLD;
+    MOV(64, R(RSCRATCH), ImmPtr(&b->tier_up_countdown));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    FixupBranch hot = J_CC(CC_Z, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+  }
+
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -1241,6 +1420,7 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_FOLLOW_HOT_BRANCHES);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -18,6 +18,9 @@
 // ----------
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include <rangeset/rangesizeset.h>
 
 #include "Common/CommonTypes.h"
@@ -32,6 +35,7 @@
 #include "Core/PowerPC/Jit64Common/TrampolineCache.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitCommon/JitPersistentCache.h"
 
 namespace PPCAnalyst
 {
@@ -84,6 +88,8 @@ public:
   // Utilities for use by opcodes
 
   void FakeBLCall(u32 after);
+  // Emits an increment of a branch profile counter.
+  void CountBranchEdge(u32* counter);
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
   void JustWriteExit(u32 destination, bool bl, u32 after);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
@@ -254,6 +260,23 @@ private:
 
   void ResetFreeMemoryRanges();
 
+  // Runs the analyzer on the block at em_address. With tiered compilation, blocks which haven't
+  // been found to be hot yet are analyzed with most optimizations disabled.
+  u32 AnalyzeBlock(u32 em_address, std::size_t block_size);
+
+  // Emits code for the block currently held in code_block/m_code_buffer and adds it to the block
+  // cache. Returns false if there wasn't enough free space in the code regions.
+  bool CompileAnalyzedBlock(u32 em_address, u32 nextPC);
+
+  // Compiles blocks recorded in the persistent cache ahead of their first execution.
+  void WarmUpFromPersistentCache(u32 em_address);
+  // Returns false if compilation had to stop because the code regions are full.
+  bool CompilePersistentCacheEntry(const JitPersistentCache::Entry& entry);
+
+  // Runs the block at em_address in the interpreter instead of compiling it if it hasn't run
+  // often enough yet. Returns false if the block should be compiled.
+  bool InterpretColdBlock(u32 em_address);
+
   JitBlockCache blocks{*this};
   TrampolineCache trampolines{*this};
 
@@ -262,10 +285,27 @@ private:
 
   Jit64AsmRoutineManager asm_routines{*this};
 
+  // Number of times a block compiled at the baseline tier runs before it is recompiled.
+  static constexpr u32 TIER_UP_THRESHOLD = 1000;
+  // Number of times a block is interpreted before it is compiled.
+  static constexpr u32 COLD_BLOCK_THRESHOLD = 4;
+
   bool m_enable_blr_optimization;
+  bool m_enable_tiering = false;
+  bool m_compiling_baseline_tier = false;
+  bool m_interpret_cold_blocks = false;
+  std::unordered_map<u32, u32> m_cold_block_runs;
+  // Filled in by blocks compiled at the baseline tier, and used to form traces at the optimized
+  // tier. Compiled code points into the map, which is fine since unordered_map never moves its
+  // elements.
+  PPCAnalyst::BranchProfile m_branch_profile;
   bool m_cleanup_after_stackfault;
   u8* m_stack;
 
+  JitPersistentCache m_persistent_cache;
+  bool m_persistent_cache_enabled = false;
+  std::string m_persistent_cache_game_id;
+
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_near;
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_far;
 };
@@ -190,9 +190,13 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(JitTrampoline);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
+  // The block may have been interpreted instead of compiled, which uses up cycles.
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  FixupBranch interpreted_bail = J_CC(CC_LE, true);
   JMP(dispatcher_no_check, true);
 
   SetJumpTarget(bail);
+  SetJumpTarget(interpreted_bail);
   do_timing = GetCodePtr();
 
   // make sure npc contains the next pc (needed for exception checking in CoreTiming::Advance)
@@ -147,12 +147,39 @@ void Jit64::bcx(UGeckoInstruction inst)
     return;
   }
 
+  if (js.op->branchFollowed)
+  {
+    // The block continues at the branch target, so only the not-taken path leaves the block.
+    SwitchToFarCode();
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+    {
+      RCForkGuard gpr_guard = gpr.Fork();
+      RCForkGuard fpr_guard = fpr.Fork();
+      gpr.Flush();
+      fpr.Flush();
+      WriteExit(js.compilerPC + 4);
+    }
+    SwitchToNearCode();
+    return;
+  }
+
+  const bool is_conditional =
+      (inst.BO & BO_DONT_DECREMENT_FLAG) == 0 || (inst.BO & BO_DONT_CHECK_CONDITION) == 0;
+  const bool profile_branch =
+      m_compiling_baseline_tier && is_conditional && !inst.LK && !js.op->branchIsIdleLoop;
+
   {
     RCForkGuard gpr_guard = gpr.Fork();
     RCForkGuard fpr_guard = fpr.Fork();
     gpr.Flush();
     fpr.Flush();
 
+    if (profile_branch)
+      CountBranchEdge(&m_branch_profile[js.compilerPC].taken);
+
     if (js.op->branchIsIdleLoop)
     {
       WriteIdleExit(js.op->branchTo);
@@ -168,6 +195,9 @@ void Jit64::bcx(UGeckoInstruction inst)
   if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
     SetJumpTarget(pCTRDontBranch);
 
+  if (profile_branch)
+    CountBranchEdge(&m_branch_profile[js.compilerPC].not_taken);
+
   if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
   {
     gpr.Flush();
@@ -176,6 +206,12 @@ void Jit64::bcx(UGeckoInstruction inst)
   }
 }
 
+void Jit64::CountBranchEdge(u32* counter)
+{
+  MOV(64, R(RSCRATCH), ImmPtr(counter));
+  ADD(32, MatR(RSCRATCH), Imm8(1));
+}
+
 void Jit64::bcctrx(UGeckoInstruction inst)
 {
   INSTRUCTION_START
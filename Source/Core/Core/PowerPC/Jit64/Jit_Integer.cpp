@@ -371,6 +371,11 @@ bool Jit64::CheckMergedBranch(u32 crf) const
   if (!CanMergeNextInstructions(1))
     return false;
 
+  // The merged branch only emits the exit for the taken path, while the block continues at the
+  // target of a followed branch. Let bcx emit the exit for the not-taken path instead.
+  if (js.op[1].branchFollowed)
+    return false;
+
   const UGeckoInstruction& next = js.op[1].inst;
   return (((next.OPCD == 16 /* bcx */) ||
            ((next.OPCD == 19) && (next.SUBOP10 == 528) /* bcctrx */) ||
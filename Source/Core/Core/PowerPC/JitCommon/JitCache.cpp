@@ -13,9 +13,9 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
@@ -34,8 +34,122 @@ using namespace Gen;
 
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  const auto it = std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address);
+  return it != physical_addresses.end() && *it - address < length;
+}
+
+// Removes the first occurrence of value from an unordered vector.
+template <typename T>
+static void EraseUnordered(std::vector<T>& vector, const T& value)
+{
+  const auto it = std::find(vector.begin(), vector.end(), value);
+  if (it == vector.end())
+    return;
+
+  *it = vector.back();
+  vector.pop_back();
+}
+
+const std::vector<JitBlock*>* BlockAddressMap::Find(u32 address) const
+{
+  if (m_size == 0)
+    return nullptr;
+
+  const size_t mask = m_slots.size() - 1;
+  for (size_t i = GetHomeSlot(address, mask); !m_slots[i].blocks.empty(); i = (i + 1) & mask)
+  {
+    if (m_slots[i].address == address)
+      return &m_slots[i].blocks;
+  }
+  return nullptr;
+}
+
+void BlockAddressMap::Insert(u32 address, JitBlock* block)
+{
+  if ((m_size + 1) * 2 > m_slots.size())
+    Rehash(std::max<size_t>(m_slots.size() * 2, 64));
+
+  const size_t mask = m_slots.size() - 1;
+  size_t i = GetHomeSlot(address, mask);
+  while (!m_slots[i].blocks.empty() && m_slots[i].address != address)
+    i = (i + 1) & mask;
+
+  std::vector<JitBlock*>& blocks = m_slots[i].blocks;
+  if (blocks.empty())
+  {
+    m_slots[i].address = address;
+    m_size++;
+  }
+  else if (std::find(blocks.begin(), blocks.end(), block) != blocks.end())
+  {
+    return;
+  }
+  blocks.push_back(block);
+}
+
+void BlockAddressMap::Erase(u32 address, JitBlock* block)
+{
+  if (m_size == 0)
+    return;
+
+  const size_t mask = m_slots.size() - 1;
+  size_t hole = GetHomeSlot(address, mask);
+  while (m_slots[hole].address != address)
+  {
+    if (m_slots[hole].blocks.empty())
+      return;
+    hole = (hole + 1) & mask;
+  }
+  // Empty slots keep the address they last held.
+  if (m_slots[hole].blocks.empty())
+    return;
+
+  EraseUnordered(m_slots[hole].blocks, block);
+  if (!m_slots[hole].blocks.empty())
+    return;
+
+  // Move later slots of the same cluster back into the hole if that doesn't put them in front
+  // of their home slot, so lookups never have to skip over deleted slots.
+  for (size_t i = (hole + 1) & mask; !m_slots[i].blocks.empty(); i = (i + 1) & mask)
+  {
+    const size_t home = GetHomeSlot(m_slots[i].address, mask);
+    if (((i - home) & mask) >= ((i - hole) & mask))
+    {
+      std::swap(m_slots[hole], m_slots[i]);
+      hole = i;
+    }
+  }
+  m_size--;
+}
+
+void BlockAddressMap::Clear()
+{
+  m_slots.clear();
+  m_size = 0;
+}
+
+size_t BlockAddressMap::GetHomeSlot(u32 address, size_t mask)
+{
+  // Block addresses are aligned, so their low bits can't be used directly.
+  return static_cast<size_t>((address * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+void BlockAddressMap::Rehash(size_t new_size)
+{
+  std::vector<Slot> old_slots(new_size);
+  std::swap(m_slots, old_slots);
+
+  const size_t mask = m_slots.size() - 1;
+  for (Slot& slot : old_slots)
+  {
+    if (slot.blocks.empty())
+      continue;
+
+    size_t i = GetHomeSlot(slot.address, mask);
+    while (!m_slots[i].blocks.empty())
+      i = (i + 1) & mask;
+    m_slots[i] = std::move(slot);
+  }
 }
 
 JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
@@ -65,13 +179,21 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
-  for (auto& e : block_map)
+  m_jit.js.hotBlockAddresses.clear();
+  block_map.ForEach([this](u32, const std::vector<JitBlock*>& blocks) {
+    for (JitBlock* block : blocks)
+      DestroyBlock(*block);
+  });
+  block_map.Clear();
+  links_to.Clear();
+  block_range_map.Clear();
+
+  m_free_blocks.clear();
+  for (auto slab = m_block_slabs.rbegin(); slab != m_block_slabs.rend(); ++slab)
   {
-    DestroyBlock(e.second);
+    for (size_t i = BLOCK_SLAB_SIZE; i > 0; i--)
+      m_free_blocks.push_back(&(*slab)[i - 1]);
   }
-  block_map.clear();
-  links_to.clear();
-  block_range_map.clear();
 
   valid_block.ClearAll();
 
@@ -91,18 +213,48 @@ JitBlock** JitBaseBlockCache::GetFastBlockMap()
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  block_map.ForEach([&f](u32, const std::vector<JitBlock*>& blocks) {
+    for (const JitBlock* block : blocks)
+      f(*block);
+  });
+}
+
+JitBlock* JitBaseBlockCache::NewBlock()
+{
+  if (m_free_blocks.empty())
+  {
+    m_block_slabs.push_back(std::make_unique<JitBlock[]>(BLOCK_SLAB_SIZE));
+    JitBlock* slab = m_block_slabs.back().get();
+    for (size_t i = BLOCK_SLAB_SIZE; i > 0; i--)
+      m_free_blocks.push_back(&slab[i - 1]);
+  }
+
+  JitBlock* block = m_free_blocks.back();
+  m_free_blocks.pop_back();
+  return block;
+}
+
+void JitBaseBlockCache::FreeBlock(JitBlock* block)
+{
+  m_free_blocks.push_back(block);
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   u32 physicalAddress = PowerPC::JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physicalAddress, JitBlock())->second;
+  JitBlock& b = *NewBlock();
+  block_map.Insert(physicalAddress, &b);
+
+  // Recycled blocks keep the capacity of their vectors to avoid reallocations.
+  static_cast<JitBlockData&>(b) = {};
+  b.linkData.clear();
+  b.physical_addresses.clear();
+  b.tier_up_countdown = 0;
+  b.profile_data = {};
+
   b.effectiveAddress = em_address;
   b.physicalAddress = physicalAddress;
   b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
-  b.linkData.clear();
   b.fast_block_map_index = 0;
   return &b;
 }
@@ -114,21 +266,19 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   fast_block_map[index] = &block;
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  block.physical_addresses.assign(physical_addresses.begin(), physical_addresses.end());
 
   u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  for (u32 addr : physical_addresses)
+  for (u32 addr : block.physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+    block_range_map.Insert(addr & range_mask, &block);
   }
 
   if (block_link)
   {
     for (const auto& e : block.linkData)
-    {
-      links_to[e.exitAddress].insert(&block);
-    }
+      links_to.Insert(e.exitAddress, &block);
 
     LinkBlock(block);
   }
@@ -160,12 +310,14 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  const std::vector<JitBlock*>* blocks = block_map.Find(translated_addr);
+  if (!blocks)
+    return nullptr;
+
+  for (JitBlock* b : *blocks)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.msrBits == (msr & JIT_CACHE_MSR_MASK))
-      return &b;
+    if (b->effectiveAddress == addr && b->msrBits == (msr & JIT_CACHE_MSR_MASK))
+      return b;
   }
 
   return nullptr;
@@ -223,50 +375,73 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
-  {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+  if (length == 0)
+    return;
+
+  // Find all macro blocks which overlap the given range. For small ranges it is cheaper to look
+  // up every macro block in the range, for large ones to scan the occupied macro blocks instead.
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  const u32 first = address & range_mask;
+  const u64 end = std::min<u64>(u64{address} + length, u64{1} << 32);
+  const u32 last = static_cast<u32>(end - 1) & range_mask;
+  const u64 num_macro_blocks = (u64{last} - first) / BLOCK_RANGE_MAP_ELEMENTS + 1;
+
+  std::vector<JitBlock*> blocks_to_erase;
+  const auto collect = [&](const std::vector<JitBlock*>& macro_block) {
+    for (JitBlock* block : macro_block)
     {
-      JitBlock* block = *iter;
       if (block->OverlapsPhysicalRange(address, length))
-      {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
+        blocks_to_erase.push_back(block);
     }
+  };
 
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+  if (num_macro_blocks <= block_range_map.Size())
+  {
+    for (u64 macro_address = first; macro_address <= last;
+         macro_address += BLOCK_RANGE_MAP_ELEMENTS)
+    {
+      if (const auto* macro_block = block_range_map.Find(static_cast<u32>(macro_address)))
+        collect(*macro_block);
+    }
+  }
+  else
+  {
+    block_range_map.ForEach([&](u32 macro_address, const std::vector<JitBlock*>& macro_block) {
+      if (macro_address >= first && macro_address <= last)
+        collect(macro_block);
+    });
+  }
+
+  // A block spanning several macro blocks of the range is found once per macro block.
+  std::sort(blocks_to_erase.begin(), blocks_to_erase.end());
+  blocks_to_erase.erase(std::unique(blocks_to_erase.begin(), blocks_to_erase.end()),
+                        blocks_to_erase.end());
+
+  for (JitBlock* block : blocks_to_erase)
+  {
+    RemoveBlockFromRangeMap(*block);
+
+    // And remove the block.
+    DestroyBlock(*block);
+    block_map.Erase(block->physicalAddress, block);
+    FreeBlock(block);
+  }
+}
+
+void JitBaseBlockCache::RemoveBlockFromRangeMap(JitBlock& block)
+{
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  u32 previous_macro_address = 0;
+  bool first = true;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 macro_address = addr & range_mask;
+    if (!first && macro_address == previous_macro_address)
+      continue;
+    first = false;
+    previous_macro_address = macro_address;
+
+    block_range_map.Erase(macro_address, &block);
   }
 }
 
@@ -299,11 +474,11 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
 void JitBaseBlockCache::LinkBlock(JitBlock& block)
 {
   LinkBlockExits(block);
-  const auto it = links_to.find(block.effectiveAddress);
-  if (it == links_to.end())
+  const std::vector<JitBlock*>* sources = links_to.Find(block.effectiveAddress);
+  if (!sources)
     return;
 
-  for (JitBlock* b2 : it->second)
+  for (JitBlock* b2 : *sources)
   {
     if (block.msrBits == b2->msrBits)
       LinkBlockExits(*b2);
@@ -319,10 +494,10 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
   }
 
   // Unlink all exits of other blocks which points to this block
-  const auto it = links_to.find(block.effectiveAddress);
-  if (it == links_to.end())
+  const std::vector<JitBlock*>* sources = links_to.Find(block.effectiveAddress);
+  if (!sources)
     return;
-  for (JitBlock* sourceBlock : it->second)
+  for (JitBlock* sourceBlock : *sources)
   {
     if (sourceBlock->msrBits != block.msrBits)
       continue;
@@ -347,14 +522,7 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 
   // Delete linking addresses
   for (const auto& e : block.linkData)
-  {
-    auto it = links_to.find(e.exitAddress);
-    if (it == links_to.end())
-      continue;
-    it->second.erase(&block);
-    if (it->second.empty())
-      links_to.erase(it);
-  }
+    links_to.Erase(e.exitAddress, &block);
 
   // Raise an signal if we are going to call this block again
   WriteDestroyBlock(block);
@@ -8,12 +8,9 @@
 #include <bitset>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <memory>
 #include <set>
 #include <type_traits>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -79,8 +76,12 @@ struct JitBlock : public JitBlockData
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // The physical addresses of all occupied instructions, sorted in ascending order.
+  std::vector<u32> physical_addresses;
+
+  // Number of runs left before a block compiled at the baseline tier is recompiled with
+  // all optimizations. Only used with tiered compilation.
+  u32 tier_up_countdown;
 
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
@@ -125,6 +126,49 @@ private:
   std::unique_ptr<u32[]> m_valid_block;
 };
 
+// Maps addresses to lists of blocks. The lists are stored inline in an open-addressing table with
+// linear probing, so looking up an address usually touches a single cache line instead of chasing
+// the nodes of a std::unordered_map. An empty list marks an empty slot.
+class BlockAddressMap final
+{
+public:
+  // Returns the blocks stored for the address, or nullptr if there are none. The pointer is only
+  // valid until the map is modified.
+  const std::vector<JitBlock*>* Find(u32 address) const;
+
+  // Adds the block to the address unless it is already stored there.
+  void Insert(u32 address, JitBlock* block);
+  // Removes the block from the address if it is stored there.
+  void Erase(u32 address, JitBlock* block);
+
+  template <typename Function>
+  void ForEach(Function function) const
+  {
+    for (const Slot& slot : m_slots)
+    {
+      if (!slot.blocks.empty())
+        function(slot.address, slot.blocks);
+    }
+  }
+
+  // Returns the number of addresses which have any blocks.
+  size_t Size() const { return m_size; }
+  void Clear();
+
+private:
+  struct Slot
+  {
+    u32 address = 0;
+    std::vector<JitBlock*> blocks;
+  };
+
+  static size_t GetHomeSlot(u32 address, size_t mask);
+  void Rehash(size_t new_size);
+
+  std::vector<Slot> m_slots;
+  size_t m_size = 0;
+};
+
 class JitBaseBlockCache
 {
 public:
@@ -170,6 +214,13 @@ protected:
   JitBase& m_jit;
 
 private:
+  // Blocks are allocated from fixed-size slabs so that pointers to them stay valid and so that
+  // they are packed closely together in memory.
+  static constexpr size_t BLOCK_SLAB_SIZE = 0x400;
+
+  JitBlock* NewBlock();
+  void FreeBlock(JitBlock* block);
+
   virtual void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) = 0;
   virtual void WriteDestroyBlock(const JitBlock& block);
 
@@ -182,19 +233,25 @@ private:
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address);
 
+  // Removes the block from every macro block of block_range_map it occupies.
+  void RemoveBlockFromRangeMap(JitBlock& block);
+
+  std::vector<std::unique_ptr<JitBlock[]>> m_block_slabs;
+  std::vector<JitBlock*> m_free_blocks;
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  BlockAddressMap links_to;  // destination_PC -> number
 
   // Map indexed by the physical address of the entry point.
   // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  BlockAddressMap block_map;  // start_addr -> block
 
   // Range of overlapping code indexed by a masked physical address.
   // This is used for invalidation of memory regions. The range is grouped
   // in macro blocks of each 0x100 bytes.
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  BlockAddressMap block_range_map;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
@@ -0,0 +1,195 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/JitCommon/JitPersistentCache.h"
+
+#include <utility>
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+namespace
+{
+constexpr u32 CACHE_FILE_MAGIC = 0x43424A44;  // "DJBC"
+constexpr u32 CACHE_FILE_VERSION = 1;
+// Blocks are limited in size by the analyzer, so anything beyond this means the file is corrupt.
+constexpr u32 MAX_RANGES_PER_ENTRY = 0x1000;
+
+#pragma pack(push, 1)
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 num_entries;
+};
+
+struct FileEntry
+{
+  u32 effective_address;
+  u32 physical_address;
+  u32 msr_bits;
+  u32 num_ranges;
+  u64 hash;
+};
+#pragma pack(pop)
+}  // Anonymous namespace
+
+std::string JitPersistentCache::GetFilename(const std::string& game_id)
+{
+  return fmt::format("{}JIT/{}.jitblocks", File::GetUserPath(D_CACHE_IDX), game_id);
+}
+
+bool JitPersistentCache::Load(const std::string& filename)
+{
+  Clear();
+
+  File::IOFile file(filename, "rb");
+  if (!file)
+    return false;
+
+  FileHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != CACHE_FILE_MAGIC ||
+      header.version != CACHE_FILE_VERSION)
+  {
+    WARN_LOG_FMT(DYNA_REC, "Ignoring invalid or outdated JIT block cache file {}", filename);
+    return false;
+  }
+
+  for (u32 i = 0; i < header.num_entries && m_entries.size() < MAX_ENTRIES; i++)
+  {
+    FileEntry file_entry;
+    if (!file.ReadArray(&file_entry, 1) || file_entry.num_ranges > MAX_RANGES_PER_ENTRY)
+      break;
+
+    Entry entry{file_entry.effective_address, file_entry.physical_address, file_entry.msr_bits,
+                file_entry.hash, {}};
+    entry.ranges.resize(file_entry.num_ranges);
+    if (!file.ReadArray(entry.ranges.data(), entry.ranges.size()))
+      break;
+
+    const Key key{entry.physical_address, entry.effective_address, entry.msr_bits};
+    m_loaded.push_back(entry);
+    m_entries.emplace(key, std::move(entry));
+  }
+
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} entries from JIT block cache file {}", m_loaded.size(),
+               filename);
+  return true;
+}
+
+bool JitPersistentCache::Save(const std::string& filename) const
+{
+  if (m_entries.empty())
+    return true;
+
+  if (!File::CreateFullPath(filename))
+    return false;
+
+  File::IOFile file(filename, "wb");
+  if (!file)
+    return false;
+
+  const FileHeader header{CACHE_FILE_MAGIC, CACHE_FILE_VERSION, static_cast<u32>(m_entries.size())};
+  bool success = file.WriteArray(&header, 1);
+  for (const auto& [key, entry] : m_entries)
+  {
+    const FileEntry file_entry{entry.effective_address, entry.physical_address, entry.msr_bits,
+                               static_cast<u32>(entry.ranges.size()), entry.hash};
+    success &= file.WriteArray(&file_entry, 1);
+    success &= file.WriteArray(entry.ranges.data(), entry.ranges.size());
+  }
+
+  if (!success)
+    ERROR_LOG_FMT(DYNA_REC, "Failed to write JIT block cache file {}", filename);
+  return success;
+}
+
+void JitPersistentCache::Clear()
+{
+  m_entries.clear();
+  m_loaded.clear();
+  m_deferred.clear();
+}
+
+void JitPersistentCache::RecordBlock(const JitBlock& block)
+{
+  if (block.physical_addresses.empty())
+    return;
+
+  Entry entry{block.effectiveAddress, block.physicalAddress, block.msrBits, 0, {}};
+  for (u32 address : block.physical_addresses)
+  {
+    if (!entry.ranges.empty() &&
+        entry.ranges.back().first + entry.ranges.back().second * 4 == address)
+    {
+      entry.ranges.back().second++;
+    }
+    else
+    {
+      entry.ranges.emplace_back(address, 1);
+    }
+  }
+
+  if (!ComputeHash(entry.ranges, &entry.hash))
+    return;
+
+  const Key key{entry.physical_address, entry.effective_address, entry.msr_bits};
+  const auto it = m_entries.find(key);
+  if (it != m_entries.end())
+    it->second = std::move(entry);
+  else if (m_entries.size() < MAX_ENTRIES)
+    m_entries.emplace(key, std::move(entry));
+}
+
+std::vector<JitPersistentCache::Entry> JitPersistentCache::TakeLoadedEntries()
+{
+  return std::exchange(m_loaded, {});
+}
+
+void JitPersistentCache::DeferEntry(Entry entry)
+{
+  m_deferred[entry.physical_address >> PAGE_SHIFT].push_back(std::move(entry));
+}
+
+std::vector<JitPersistentCache::Entry> JitPersistentCache::TakeDeferredEntries(u32 physical_address)
+{
+  const auto it = m_deferred.find(physical_address >> PAGE_SHIFT);
+  if (it == m_deferred.end())
+    return {};
+
+  std::vector<Entry> entries = std::move(it->second);
+  m_deferred.erase(it);
+  return entries;
+}
+
+bool JitPersistentCache::MatchesMemory(const Entry& entry)
+{
+  u64 hash;
+  return ComputeHash(entry.ranges, &hash) && hash == entry.hash;
+}
+
+bool JitPersistentCache::ComputeHash(const std::vector<std::pair<u32, u32>>& ranges, u64* hash)
+{
+  std::vector<u8> data;
+  for (const auto& [address, count] : ranges)
+  {
+    const u32 size = count * sizeof(u32);
+    const u8* ptr = Memory::TryGetPointerForRange(address, size);
+    if (!ptr)
+      return false;
+
+    const u8* address_bytes = reinterpret_cast<const u8*>(&address);
+    data.insert(data.end(), address_bytes, address_bytes + sizeof(address));
+    data.insert(data.end(), ptr, ptr + size);
+  }
+  *hash = XXH64(data.data(), data.size(), 0);
+  return true;
+}
@@ -0,0 +1,73 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+struct JitBlock;
+
+// Remembers which blocks were compiled while a game was running, so that the next time the same
+// game is booted, these blocks can be compiled up front instead of the first time they are
+// executed. Only block descriptors are stored, never host code: every block is recompiled from
+// the guest code which is in memory at the time, so a stale entry can never cause a block to be
+// miscompiled. The stored hash of the guest instructions is only used to skip entries whose code
+// isn't (or isn't yet) present in memory.
+class JitPersistentCache
+{
+public:
+  struct Entry
+  {
+    u32 effective_address;
+    u32 physical_address;
+    u32 msr_bits;
+    u64 hash;
+    // Runs of consecutive instructions covered by the block: (physical address, instruction count).
+    std::vector<std::pair<u32, u32>> ranges;
+  };
+
+  // Upper bound on the number of entries kept, to keep the file size reasonable for games
+  // which generate code at runtime.
+  static constexpr size_t MAX_ENTRIES = 0x40000;
+
+  static std::string GetFilename(const std::string& game_id);
+
+  bool Load(const std::string& filename);
+  bool Save(const std::string& filename) const;
+  void Clear();
+
+  // Records a block which was just compiled. Blocks which aren't entirely backed by RAM are ignored.
+  void RecordBlock(const JitBlock& block);
+
+  // Returns the entries loaded from disk which haven't been handed out yet.
+  std::vector<Entry> TakeLoadedEntries();
+  // Keeps an entry whose code wasn't in memory yet, so that it can be retried once the JIT first
+  // compiles code in the same page.
+  void DeferEntry(Entry entry);
+  // Returns and forgets the deferred entries which start in the page containing the given
+  // physical address.
+  std::vector<Entry> TakeDeferredEntries(u32 physical_address);
+  bool HasDeferredEntries() const { return !m_deferred.empty(); }
+
+  // Returns true if the guest code described by the entry is currently in memory.
+  static bool MatchesMemory(const Entry& entry);
+
+private:
+  using Key = std::tuple<u32, u32, u32>;
+
+  static constexpr u32 PAGE_SHIFT = 12;
+
+  static bool ComputeHash(const std::vector<std::pair<u32, u32>>& ranges, u64* hash);
+
+  std::map<Key, Entry> m_entries;
+  std::vector<Entry> m_loaded;
+  std::unordered_map<u32, std::vector<Entry>> m_deferred;
+};
@@ -40,6 +40,12 @@ namespace PPCAnalyst
 {
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+// Hot conditional branches are followed separately from unconditional ones. A branch is hot if it
+// ran often enough to be representative, and was taken at least HOT_BRANCH_RATIO times as often
+// as not.
+constexpr u32 HOT_BRANCH_FOLLOWING_THRESHOLD = 4;
+constexpr u32 HOT_BRANCH_MIN_SAMPLES = 64;
+constexpr u32 HOT_BRANCH_RATIO = 8;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
@@ -731,6 +737,30 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
   return false;
 }
 
+bool PPCAnalyzer::IsHotBranch(const CodeOp* code, size_t index) const
+{
+  const CodeOp& op = code[index];
+  if (!HasOption(OPTION_FOLLOW_HOT_BRANCHES) || !m_branch_profile || op.inst.OPCD != 16 ||
+      op.inst.LK || op.branchIsIdleLoop)
+  {
+    return false;
+  }
+
+  const auto it = m_branch_profile->find(op.address);
+  if (it == m_branch_profile->end())
+    return false;
+  const BranchEdgeCounts& counts = it->second;
+  if (u64{counts.taken} + counts.not_taken < HOT_BRANCH_MIN_SAMPLES ||
+      counts.taken < u64{counts.not_taken} * HOT_BRANCH_RATIO)
+  {
+    return false;
+  }
+
+  // Don't unroll loops: the target must not already be part of the block.
+  return std::none_of(code, code + index + 1,
+                      [&op](const CodeOp& other) { return other.address == op.branchTo; });
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size)
 {
   // Clear block stats
@@ -759,6 +789,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
   bool found_call = false;
   size_t caller = 0;
   u32 numFollows = 0;
+  u32 numHotFollows = 0;
   u32 num_inst = 0;
 
   const bool enable_follow = SConfig::GetInstance().bJITFollowBranch;
@@ -888,6 +919,15 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
       numFollows++;
       address = code[i].branchTo;
     }
+    else if (conditional_continue && enable_follow && block_size > 1 &&
+             numHotFollows < HOT_BRANCH_FOLLOWING_THRESHOLD && IsHotBranch(code, i))
+    {
+      // Follow the taken path of the conditional branch, leaving the block on the other one.
+      numHotFollows++;
+      code[i].branchFollowed = true;
+      address = code[i].branchTo;
+      found_call = false;
+    }
     else
     {
       // Just pick the next instruction
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -22,6 +23,14 @@ struct Symbol;
 
 namespace PPCAnalyst
 {
+// How often each path of a conditional branch was executed, keyed by the branch's address.
+struct BranchEdgeCounts
+{
+  u32 taken = 0;
+  u32 not_taken = 0;
+};
+using BranchProfile = std::unordered_map<u32, BranchEdgeCounts>;
+
 struct CodeOp  // 16B
 {
   UGeckoInstruction inst;
@@ -48,6 +57,8 @@ struct CodeOp  // 16B
   bool canCauseException;
   bool skipLRStack;
   bool skip;  // followed BL-s for example
+  // The block continues at branchTo, so the not-taken path of this conditional branch leaves it.
+  bool branchFollowed;
   // which registers are still needed after this instruction in this block
   BitSet32 fprInUse;
   BitSet32 gprInUse;
@@ -209,12 +220,18 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Continue the block at the target of conditional branches which the branch profile shows
+    // are almost always taken, turning hot paths through several basic blocks into one trace.
+    // The not-taken path becomes a side exit. Requires JIT support and SetBranchProfile.
+    OPTION_FOLLOW_HOT_BRANCHES = (1 << 7),
   };
 
   // Option setting/getting
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+  void SetBranchProfile(const BranchProfile* profile) { m_branch_profile = profile; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size);
 
 private:
@@ -229,9 +246,11 @@ private:
   void ReorderInstructions(u32 instructions, CodeOp* code);
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo, u32 index);
   bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions);
+  bool IsHotBranch(const CodeOp* code, size_t index) const;
 
   // Options
   u32 m_options = 0;
+  const BranchProfile* m_branch_profile = nullptr;
 };
 
 void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db);
@@ -0,0 +1,249 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/Rewind.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/State.h"
+#include "Core/StateDelta.h"
+
+#include "VideoCommon/OnScreenDisplay.h"
+
+namespace Rewind
+{
+// Deltas mostly consist of emulated RAM, which compresses well even at the fastest level.
+constexpr int DELTA_COMPRESSION_LEVEL = 1;
+
+struct HistoryEntry
+{
+  // A zstd-compressed State::StateDelta which turns the next newer capture into this one.
+  std::vector<u8> compressed_delta;
+  size_t delta_size;
+};
+
+static bool s_enabled;
+static u32 s_configured_interval;
+static u64 s_memory_budget;
+static u32 s_frame_budget_us;
+
+// Only accessed on the CPU thread, or with the CPU thread paused.
+static std::vector<u8> s_newest_state;
+static std::deque<HistoryEntry> s_history;
+static u64 s_history_size;
+static u32 s_fields_since_capture;
+// Whether the emulated state is still the one s_newest_state was captured or loaded from.
+static bool s_at_newest_state;
+
+static std::atomic<bool> s_capture_pending;
+static std::atomic<u32> s_interval;
+
+// These are read by the stats overlay on the GPU thread.
+static std::atomic<u32> s_num_states;
+static std::atomic<u64> s_memory_usage;
+static std::atomic<u32> s_capture_time_us;
+
+static void UpdateStatistics()
+{
+  s_num_states.store(static_cast<u32>(s_history.size() + !s_newest_state.empty()));
+  s_memory_usage.store(s_history_size + s_newest_state.size());
+}
+
+static void Clear()
+{
+  s_newest_state.clear();
+  s_newest_state.shrink_to_fit();
+  s_history.clear();
+  s_history_size = 0;
+  s_fields_since_capture = 0;
+  s_at_newest_state = false;
+  s_capture_pending.store(false);
+  s_interval.store(s_configured_interval);
+  s_capture_time_us.store(0);
+  UpdateStatistics();
+}
+
+void Init()
+{
+  s_enabled = Config::Get(Config::MAIN_REWIND_ENABLE);
+  s_configured_interval = std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1);
+  s_memory_budget = static_cast<u64>(std::max(Config::Get(Config::MAIN_REWIND_MEMORY_BUDGET), 0))
+                    << 20;
+  s_frame_budget_us = std::max(Config::Get(Config::MAIN_REWIND_FRAME_BUDGET), 1);
+  Clear();
+}
+
+void Shutdown()
+{
+  Clear();
+  s_enabled = false;
+}
+
+bool IsEnabled()
+{
+  return s_enabled;
+}
+
+static bool CompressDelta(State::StateDelta& delta, HistoryEntry* entry)
+{
+  std::vector<u8> buffer;
+  u8* ptr = nullptr;
+  PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
+  delta.DoState(p);
+  buffer.resize(reinterpret_cast<size_t>(ptr));
+  ptr = buffer.data();
+  p.SetMode(PointerWrap::MODE_WRITE);
+  delta.DoState(p);
+
+  entry->delta_size = buffer.size();
+  entry->compressed_delta.resize(ZSTD_compressBound(buffer.size()));
+  const size_t compressed_size =
+      ZSTD_compress(entry->compressed_delta.data(), entry->compressed_delta.size(), buffer.data(),
+                    buffer.size(), DELTA_COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size))
+    return false;
+
+  entry->compressed_delta.resize(compressed_size);
+  entry->compressed_delta.shrink_to_fit();
+  return true;
+}
+
+static bool DecompressDelta(const HistoryEntry& entry, State::StateDelta* delta)
+{
+  std::vector<u8> buffer(entry.delta_size);
+  const size_t result = ZSTD_decompress(buffer.data(), buffer.size(), entry.compressed_delta.data(),
+                                        entry.compressed_delta.size());
+  if (ZSTD_isError(result) || result != buffer.size())
+    return false;
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, PointerWrap::MODE_READ);
+  delta->DoState(p);
+  return p.GetMode() == PointerWrap::MODE_READ;
+}
+
+// Runs on the CPU thread, between blocks.
+static void Capture()
+{
+  const u64 start_time = Common::Timer::GetTimeUs();
+
+  std::vector<u8> state;
+  State::SaveToBuffer(state);
+
+  if (!s_newest_state.empty())
+  {
+    State::StateDelta delta(state, s_newest_state);
+    HistoryEntry entry;
+    if (CompressDelta(delta, &entry))
+    {
+      s_history_size += entry.compressed_delta.size();
+      s_history.push_back(std::move(entry));
+    }
+    else
+    {
+      // Older captures can only be reached through this one.
+      s_history.clear();
+      s_history_size = 0;
+    }
+  }
+  s_newest_state = std::move(state);
+
+  while (!s_history.empty() && s_history_size + s_newest_state.size() > s_memory_budget)
+  {
+    s_history_size -= s_history.front().compressed_delta.size();
+    s_history.pop_front();
+  }
+
+  s_fields_since_capture = 0;
+  s_at_newest_state = true;
+  UpdateStatistics();
+
+  // Spread the cost of a capture over enough fields that it stays within the per-frame budget.
+  // This is recomputed on every capture, so the interval recovers once captures get cheaper.
+  const u32 capture_time = static_cast<u32>(Common::Timer::GetTimeUs() - start_time);
+  const u32 min_interval = (capture_time + s_frame_budget_us - 1) / s_frame_budget_us;
+  s_capture_time_us.store(capture_time);
+  s_interval.store(std::max(s_configured_interval, min_interval));
+}
+
+void OnNewField()
+{
+  if (!s_enabled)
+    return;
+
+  s_at_newest_state = false;
+  if (++s_fields_since_capture < s_interval.load() || s_capture_pending.exchange(true))
+    return;
+
+  // Savestates can't be taken from inside a CoreTiming event, so the CPU thread has to be
+  // stopped between blocks. This is the same path every other savestate takes.
+  Core::QueueHostJob([] {
+    Core::RunOnCPUThread(
+        [] {
+          if (s_enabled && s_capture_pending.load())
+            Capture();
+          s_capture_pending.store(false);
+        },
+        true);
+  });
+}
+
+bool StepBack()
+{
+  if (!s_enabled)
+    return false;
+
+  bool success = false;
+  Core::RunOnCPUThread(
+      [&] {
+        if (s_newest_state.empty())
+          return;
+
+        // The first step only returns to the newest capture.
+        if (s_at_newest_state)
+        {
+          if (s_history.empty())
+            return;
+
+          State::StateDelta delta;
+          if (!DecompressDelta(s_history.back(), &delta))
+          {
+            OSD::AddMessage("Failed to decompress rewind state");
+            return;
+          }
+
+          delta.Apply(&s_newest_state);
+          s_history_size -= s_history.back().compressed_delta.size();
+          s_history.pop_back();
+        }
+
+        State::LoadFromBuffer(s_newest_state);
+        s_fields_since_capture = 0;
+        s_at_newest_state = true;
+        s_capture_pending.store(false);
+        UpdateStatistics();
+        success = true;
+      },
+      true);
+
+  return success;
+}
+
+Statistics GetStatistics()
+{
+  return {s_num_states.load(), s_memory_usage.load(), s_capture_time_us.load(), s_interval.load()};
+}
+}  // namespace Rewind
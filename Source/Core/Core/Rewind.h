@@ -0,0 +1,38 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Rewind keeps a bounded, in-memory history of recent savestates which can be stepped back
+// through. The newest capture is kept in full; every older one is stored as a compressed
+// StateDelta against the capture that followed it.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace Rewind
+{
+struct Statistics
+{
+  u32 num_states;
+  u64 memory_usage;
+  // Time the last capture took on the CPU thread.
+  u32 capture_time_us;
+  // Number of fields between captures, after adapting to the per-frame budget.
+  u32 interval;
+};
+
+void Init();
+void Shutdown();
+
+bool IsEnabled();
+
+// Called on the CPU thread at the start of every field.
+void OnNewField();
+
+// Loads the most recent captured state. Calling this again right afterwards loads the capture
+// before it. Returns false if there is no captured state to go back to.
+bool StepBack();
+
+Statistics GetStatistics();
+}  // namespace Rewind
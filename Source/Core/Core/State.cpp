@@ -4,6 +4,9 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <lzo/lzo1x.h>
 #include <map>
 #include <mutex>
@@ -13,6 +16,7 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -25,6 +29,7 @@
 #include "Common/Timer.h"
 #include "Common/Version.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -55,10 +60,21 @@ static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
 static unsigned char __LZO_MMODEL out[OUT_LEN];
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
+// States are saved as independently compressed zstd chunks, so that they can be compressed and
+// decompressed on several threads. Older states consist of LZO chunks of at most OUT_LEN bytes,
+// each preceded by its size. In newer states, this magic number takes the place of the size of
+// the first chunk, followed by ZstdHeader and the chunks, each also preceded by its size.
+constexpr u32 ZSTD_STATE_MAGIC = 0x5A545344;  // "DSTZ"
+constexpr u32 ZSTD_CHUNK_SIZE = 1024 * 1024;
+constexpr u32 MAX_COMPRESSION_THREADS = 8;
 
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+#pragma pack(push, 1)
+struct ZstdHeader
+{
+  u32 magic;
+  u32 chunk_size;
+};
+#pragma pack(pop)
 
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
@@ -302,9 +318,86 @@ struct CompressAndDumpState_args
   std::vector<u8>* buffer_vector;
   std::mutex* buffer_mutex;
   std::string filename;
+  int compression_level;
   bool wait;
 };
 
+static u32 GetNumCompressionThreads(size_t num_chunks)
+{
+  const u32 num_threads = std::clamp(std::thread::hardware_concurrency(), 1u,
+                                     MAX_COMPRESSION_THREADS);
+  return static_cast<u32>(std::min<size_t>(num_threads, num_chunks));
+}
+
+// Runs func(i) for every i in [0, count) on up to num_threads threads, including the calling one.
+template <typename Func>
+static void RunInParallel(size_t count, u32 num_threads, Func func)
+{
+  std::atomic<size_t> next{0};
+  const auto worker = [&] {
+    for (size_t i = next++; i < count; i = next++)
+      func(i);
+  };
+
+  std::vector<std::thread> threads;
+  for (u32 i = 1; i < num_threads; i++)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+// Compresses the state in chunks on several threads. Chunks are written in order as soon as they
+// are ready, so writing overlaps with compressing the rest.
+static bool WriteCompressedState(File::IOFile& f, const u8* data, size_t size,
+                                 int compression_level)
+{
+  const size_t num_chunks = (size + ZSTD_CHUNK_SIZE - 1) / ZSTD_CHUNK_SIZE;
+  std::vector<std::vector<u8>> chunks(num_chunks);
+  std::vector<bool> chunk_ready(num_chunks);
+  bool compression_failed = false;
+  std::mutex mutex;
+  std::condition_variable chunk_ready_cv;
+
+  std::thread compress_thread([&] {
+    RunInParallel(num_chunks, GetNumCompressionThreads(num_chunks), [&](size_t i) {
+      const size_t in_size = std::min<size_t>(ZSTD_CHUNK_SIZE, size - i * ZSTD_CHUNK_SIZE);
+      std::vector<u8> chunk(ZSTD_compressBound(in_size));
+      const size_t out_size = ZSTD_compress(chunk.data(), chunk.size(), data + i * ZSTD_CHUNK_SIZE,
+                                            in_size, compression_level);
+      chunk.resize(ZSTD_isError(out_size) ? 0 : out_size);
+
+      {
+        std::lock_guard lk(mutex);
+        compression_failed |= ZSTD_isError(out_size);
+        chunks[i] = std::move(chunk);
+        chunk_ready[i] = true;
+      }
+      chunk_ready_cv.notify_one();
+    });
+  });
+
+  const ZstdHeader zstd_header{ZSTD_STATE_MAGIC, ZSTD_CHUNK_SIZE};
+  bool success = f.WriteArray(&zstd_header, 1);
+  for (size_t i = 0; i < num_chunks; i++)
+  {
+    std::vector<u8> chunk;
+    {
+      std::unique_lock lk(mutex);
+      chunk_ready_cv.wait(lk, [&] { return chunk_ready[i]; });
+      chunk = std::move(chunks[i]);
+    }
+
+    const u32 chunk_size = static_cast<u32>(chunk.size());
+    success &= f.WriteArray(&chunk_size, 1) && f.WriteBytes(chunk.data(), chunk.size());
+  }
+
+  compress_thread.join();
+  if (compression_failed)
+    PanicAlertFmtT("Internal zstd error - compression failed");
+  return success && !compression_failed;
+}
+
 static void CompressAndDumpState(CompressAndDumpState_args save_args)
 {
   std::lock_guard lk(*save_args.buffer_mutex);
@@ -363,39 +456,16 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   f.WriteArray(&header, 1);
 
+  bool success;
   if (header.size != 0)  // non-zero header size means the state is compressed
-  {
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
-    }
-  }
+    success = WriteCompressedState(f, buffer_data, buffer_size, save_args.compression_level);
   else  // uncompressed
+    success = f.WriteBytes(buffer_data, buffer_size);
+
+  if (!success)
   {
-    f.WriteBytes(buffer_data, buffer_size);
+    Core::DisplayMessage("Could not save state", 2000);
+    return;
   }
 
   Core::DisplayMessage(fmt::format("Saved State to {}", filename), 2000);
@@ -434,6 +504,7 @@ void SaveAs(const std::string& filename, bool wait)
           save_args.buffer_vector = &g_current_buffer;
           save_args.buffer_mutex = &g_cs_current_buffer;
           save_args.filename = filename;
+          save_args.compression_level = Config::Get(Config::MAIN_STATE_COMPRESSION_LEVEL);
           save_args.wait = wait;
 
           Flush();
@@ -482,6 +553,37 @@ u64 GetUnixTimeOfSlot(int slot)
          (Common::Timer::DOUBLE_TIME_OFFSET * MS_PER_SEC);
 }
 
+// Reads all zstd chunks first, then decompresses them on several threads.
+static bool ReadCompressedState(File::IOFile& f, std::vector<u8>& buffer)
+{
+  ZstdHeader zstd_header;
+  if (!f.ReadArray(&zstd_header, 1) || zstd_header.chunk_size == 0)
+    return false;
+
+  const size_t chunk_size = zstd_header.chunk_size;
+  const size_t num_chunks = (buffer.size() + chunk_size - 1) / chunk_size;
+  std::vector<std::vector<u8>> chunks(num_chunks);
+  for (std::vector<u8>& chunk : chunks)
+  {
+    u32 compressed_size;
+    if (!f.ReadArray(&compressed_size, 1) || compressed_size > ZSTD_compressBound(chunk_size))
+      return false;
+    chunk.resize(compressed_size);
+    if (!f.ReadBytes(chunk.data(), chunk.size()))
+      return false;
+  }
+
+  std::atomic<bool> success{true};
+  RunInParallel(num_chunks, GetNumCompressionThreads(num_chunks), [&](size_t i) {
+    const size_t out_size = std::min(chunk_size, buffer.size() - i * chunk_size);
+    const size_t result = ZSTD_decompress(buffer.data() + i * chunk_size, out_size,
+                                          chunks[i].data(), chunks[i].size());
+    if (ZSTD_isError(result) || result != out_size)
+      success = false;
+  });
+  return success;
+}
+
 static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
 {
   Flush();
@@ -510,27 +612,45 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     buffer.resize(header.size);
 
-    lzo_uint i = 0;
-    while (true)
+    u32 first_chunk_size;
+    if (!f.ReadArray(&first_chunk_size, 1) || !f.Seek(-s64{sizeof(first_chunk_size)}, SEEK_CUR))
     {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
-
-      if (!f.ReadArray(&cur_len, 1))
-        break;
+      Core::DisplayMessage("The savestate could not be loaded", 2000);
+      return;
+    }
 
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
+    if (first_chunk_size == ZSTD_STATE_MAGIC)
+    {
+      if (!ReadCompressedState(f, buffer))
       {
-        // This doesn't seem to happen anymore.
-        PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
-                       "Try loading the state again",
-                       res, i, new_len);
+        PanicAlertFmtT("Internal zstd error - decompression failed\nTry loading the state again");
         return;
       }
+    }
+    else
+    {
+      lzo_uint i = 0;
+      while (true)
+      {
+        lzo_uint32 cur_len = 0;  // number of bytes to read
+        lzo_uint new_len = 0;    // number of bytes to write
 
-      i += new_len;
+        if (!f.ReadArray(&cur_len, 1))
+          break;
+
+        f.ReadBytes(out, cur_len);
+        const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
+        if (res != LZO_E_OK)
+        {
+          // This doesn't seem to happen anymore.
+          PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
+                         "Try loading the state again",
+                         res, i, new_len);
+          return;
+        }
+
+        i += new_len;
+      }
     }
   }
   else  // uncompressed
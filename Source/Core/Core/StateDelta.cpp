@@ -0,0 +1,108 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Common/ChunkFile.h"
+
+namespace State
+{
+StateDelta::StateDelta(const std::vector<u8>& reference, const std::vector<u8>& state)
+    : m_state_size(state.size())
+{
+  const size_t num_pages = (state.size() + PAGE_SIZE - 1) / PAGE_SIZE;
+  for (size_t page = 0; page < num_pages; page++)
+  {
+    const size_t offset = page * PAGE_SIZE;
+    const size_t size = std::min(PAGE_SIZE, state.size() - offset);
+
+    // Pages which extend past the end of the reference always count as changed.
+    if (offset + size <= reference.size() &&
+        std::memcmp(reference.data() + offset, state.data() + offset, size) == 0)
+    {
+      continue;
+    }
+
+    m_pages.push_back(static_cast<u32>(page));
+    m_data.insert(m_data.end(), state.begin() + offset, state.begin() + offset + size);
+  }
+}
+
+size_t StateDelta::GetPageSize(u32 page) const
+{
+  return std::min(PAGE_SIZE, m_state_size - page * PAGE_SIZE);
+}
+
+void StateDelta::Apply(std::vector<u8>* buffer) const
+{
+  buffer->resize(m_state_size);
+
+  const u8* data = m_data.data();
+  for (u32 page : m_pages)
+  {
+    const size_t size = GetPageSize(page);
+    std::memcpy(buffer->data() + page * PAGE_SIZE, data, size);
+    data += size;
+  }
+}
+
+void StateDelta::Compact(const StateDelta& newer)
+{
+  std::vector<u32> pages;
+  std::vector<u8> data;
+  pages.reserve(m_pages.size() + newer.m_pages.size());
+  data.reserve(std::max(m_data.size(), newer.m_data.size()));
+
+  const u8* older_data = m_data.data();
+  const u8* newer_data = newer.m_data.data();
+  auto older_it = m_pages.begin();
+  auto newer_it = newer.m_pages.begin();
+  while (older_it != m_pages.end() || newer_it != newer.m_pages.end())
+  {
+    const bool take_newer =
+        newer_it != newer.m_pages.end() && (older_it == m_pages.end() || *newer_it <= *older_it);
+    const bool skip_older = older_it != m_pages.end() &&
+                            (newer_it == newer.m_pages.end() || *older_it <= *newer_it);
+
+    if (take_newer)
+    {
+      const size_t size = newer.GetPageSize(*newer_it);
+      pages.push_back(*newer_it);
+      data.insert(data.end(), newer_data, newer_data + size);
+      newer_data += size;
+      ++newer_it;
+    }
+
+    if (skip_older)
+    {
+      const u32 page = *older_it;
+      const size_t size = GetPageSize(page);
+      // Pages which newer doesn't contain are unchanged in newer's state, as far as they're still
+      // part of it. A page at the end of the state can't have grown, since newer would contain it.
+      if (!take_newer && page * PAGE_SIZE < newer.m_state_size)
+      {
+        pages.push_back(page);
+        data.insert(data.end(), older_data, older_data + newer.GetPageSize(page));
+      }
+      older_data += size;
+      ++older_it;
+    }
+  }
+
+  m_state_size = newer.m_state_size;
+  m_pages = std::move(pages);
+  m_data = std::move(data);
+}
+
+void StateDelta::DoState(PointerWrap& p)
+{
+  p.Do(m_state_size);
+  p.Do(m_pages);
+  p.Do(m_data);
+}
+}  // namespace State
@@ -0,0 +1,59 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class PointerWrap;
+
+namespace State
+{
+// Savestates taken in quick succession mostly contain the same data, since most of emulated RAM
+// doesn't change between them. A StateDelta stores a savestate buffer as the pages which differ
+// from a reference buffer, which is usually an adjacent savestate.
+//
+// Changed pages are found by comparing against the reference rather than by tracking writes:
+// emulated memory is written by the JITs' fastmem code, DMA and the GPU, and comparing catches all
+// of them for about the cost of copying the state once.
+class StateDelta
+{
+public:
+  static constexpr size_t PAGE_SIZE = 0x1000;
+
+  StateDelta() = default;
+  // Creates a delta which turns reference into state.
+  StateDelta(const std::vector<u8>& reference, const std::vector<u8>& state);
+
+  // Turns the buffer, which must hold the reference this delta was created from, into the state.
+  void Apply(std::vector<u8>* buffer) const;
+
+  // Merges a delta whose reference is the state produced by this one. Afterwards, this delta turns
+  // its original reference directly into newer's state, and contains each page only once.
+  void Compact(const StateDelta& newer);
+
+  void DoState(PointerWrap& p);
+
+  size_t GetStateSize() const { return m_state_size; }
+  size_t GetNumPages() const { return m_pages.size(); }
+  // Number of bytes of memory used by the delta's contents.
+  size_t GetMemoryUsage() const
+  {
+    return m_pages.size() * sizeof(u32) + m_data.size() + sizeof(*this);
+  }
+
+private:
+  size_t GetPageSize(u32 page) const;
+
+  size_t m_state_size = 0;
+  // Indices of the stored pages, in ascending order.
+  std::vector<u32> m_pages;
+  // Contents of the stored pages, back to back. Only the page at the end of the state can be
+  // shorter than PAGE_SIZE.
+  std::vector<u8> m_data;
+};
+}  // namespace State
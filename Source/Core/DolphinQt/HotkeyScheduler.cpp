@@ -573,6 +573,9 @@ void HotkeyScheduler::Run()
     if (IsHotkey(HK_LOAD_STATE_FILE))
       emit StateLoadFile();
 
+    if (IsHotkey(HK_REWIND))
+      emit StateRewind();
+
     if (IsHotkey(HK_SAVE_STATE_FILE))
       emit StateSaveFile();
   }
@@ -46,6 +46,7 @@ signals:
   void StateSaveFile();
   void StateLoadUndo();
   void StateSaveUndo();
+  void StateRewind();
   void StartRecording();
   void ExportRecording();
   void ToggleReadOnlyMode();
@@ -56,6 +56,7 @@
 #include "Core/NetPlayClient.h"
 #include "Core/NetPlayProto.h"
 #include "Core/NetPlayServer.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
 #include "Core/WiiUtils.h"
 
@@ -564,6 +565,7 @@ void MainWindow::ConnectHotkeys()
           &MainWindow::StateLoadLastSavedAt);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadUndo, this, &MainWindow::StateLoadUndo);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveUndo, this, &MainWindow::StateSaveUndo);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::StateRewind, this, &MainWindow::StateRewind);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveOldest, this,
           &MainWindow::StateSaveOldest);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveFile, this, &MainWindow::StateSave);
@@ -1273,6 +1275,12 @@ void MainWindow::StateSaveUndo()
   State::UndoSaveState();
 }
 
+void MainWindow::StateRewind()
+{
+  if (!Rewind::StepBack())
+    Core::DisplayMessage("No rewind state available", 2000);
+}
+
 void MainWindow::StateSaveOldest()
 {
   State::SaveFirstSaved();
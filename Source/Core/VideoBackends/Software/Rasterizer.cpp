@@ -5,12 +5,21 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Thread.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
@@ -21,22 +30,85 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// With multiple threads, the triangles of a batch are sorted into bins for square tiles of the
+// EFB, and each tile is then rasterized by one thread, in submission order. This must be a
+// multiple of BLOCK_SIZE so that no block straddles two tiles.
+static constexpr s32 TILE_SIZE = 32;
+static constexpr s32 NUM_TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr s32 NUM_TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0, "Blocks must not straddle tiles");
+static_assert(BLOCK_SIZE * BLOCK_SIZE == Tev::NUM_LANES, "Tev shades one block at a time");
+
+// Everything needed to rasterize a triangle once it has been set up.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  s32 vertex0X;
+  s32 vertex0Y;
+  float vertexOffsetX;
+  float vertexOffsetY;
+
+  // Half-edge constants and deltas, in 28.4 fixed point
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle after scissoring. minx and miny are aligned to BLOCK_SIZE.
+  s32 minx, maxx, miny, maxy;
+};
+
+// State of one rasterizer thread.
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  const TriangleSetup* triangle = nullptr;
+  u32 rasterized_pixels = 0;
+};
+
+// Kept across triangles for zfreeze.
 static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
 
-static s32 vertex0X;
-static s32 vertex0Y;
-static float vertexOffsetX;
-static float vertexOffsetY;
+// The first context belongs to the thread submitting triangles. Tev holds pointers into itself,
+// so contexts must never move.
+static std::vector<std::unique_ptr<RasterContext>> s_contexts;
+
+static std::vector<TriangleSetup> s_triangles;
+static std::array<std::vector<u32>, NUM_TILES_X * NUM_TILES_Y> s_bins;
+static std::vector<u32> s_active_tiles;
+static std::atomic<u32> s_next_active_tile;
+
+static std::vector<std::thread> s_workers;
+static std::mutex s_workers_mutex;
+static std::condition_variable s_work_available;
+static std::condition_variable s_work_done;
+static u32 s_work_generation;
+static u32 s_workers_busy;
+static bool s_workers_exit;
 
-static Tev tev;
-static RasterBlock rasterBlock;
+static void WorkerThread(RasterContext* context, u32 generation);
 
 void Init()
 {
-  tev.Init();
+  const u32 num_threads = g_ActiveConfig.GetSWRasterizerThreads();
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    s_contexts.push_back(std::make_unique<RasterContext>());
+    s_contexts.back()->tev.Init();
+  }
+
+  // The workers have to start from the current generation, since the first flush could bump it
+  // before a worker gets to read it and then wait for that worker forever.
+  {
+    std::lock_guard lk(s_workers_mutex);
+    s_workers_exit = false;
+    for (u32 i = 1; i < num_threads; i++)
+      s_workers.emplace_back(WorkerThread, s_contexts[i].get(), s_work_generation);
+  }
 
   // Set initial z reference plane in the unlikely case that zfreeze is enabled when drawing the
   // first primitive.
@@ -45,6 +117,24 @@ void Init()
   ZSlope.f0 = 1.f;
 }
 
+void Shutdown()
+{
+  {
+    std::lock_guard lk(s_workers_mutex);
+    s_workers_exit = true;
+  }
+  s_work_available.notify_all();
+  for (std::thread& worker : s_workers)
+    worker.join();
+  s_workers.clear();
+
+  s_contexts.clear();
+  s_triangles.clear();
+  for (std::vector<u32>& bin : s_bins)
+    bin.clear();
+  s_active_tiles.clear();
+}
+
 // Returns approximation of log2(f) in s28.4
 // results are close enough to use for LOD
 static s32 FixedLog2(float f)
@@ -69,58 +159,80 @@ static inline int iround(float x)
 
 void SetTevReg(int reg, int comp, s16 color)
 {
-  tev.SetRegColor(reg, comp, color);
+  for (auto& context : s_contexts)
+    context->tev.SetRegColor(reg, comp, color);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+// Shades the pixels of the block at (x, y) which are set in coverage_mask as one quad.
+static void Draw(RasterContext& context, s32 x, s32 y, u32 coverage_mask)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  const TriangleSetup& triangle = *context.triangle;
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
 
-  float dx = vertexOffsetX + (float)(x - vertex0X);
-  float dy = vertexOffsetY + (float)(y - vertex0Y);
-
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
-
-  if (bpmem.UseEarlyDepthTest() && g_ActiveConfig.bZComploc)
+  for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
-    // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
-    if (bpmem.zmode.testenable)
+    for (s32 xi = 0; xi < BLOCK_SIZE; xi++)
     {
-      // early z
-      if (!EfbInterface::ZCompare(x, y, z))
-        return;
-    }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
-  }
+      const u32 lane = xi + yi * BLOCK_SIZE;
+      if (!(coverage_mask & (1u << lane)))
+        continue;
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+      context.rasterized_pixels++;
 
-  tev.Position[0] = x;
-  tev.Position[1] = y;
-  tev.Position[2] = z;
+      float dx = triangle.vertexOffsetX + (float)(x + xi - triangle.vertex0X);
+      float dy = triangle.vertexOffsetY + (float)(y + yi - triangle.vertex0Y);
 
-  //  colors
-  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
-  {
-    for (int comp = 0; comp < 4; comp++)
-    {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(dx, dy);
+      s32 z = (s32)std::clamp<float>(triangle.ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
+
+      if (bpmem.UseEarlyDepthTest() && g_ActiveConfig.bZComploc)
+      {
+        // TODO: Test if perf regs are incremented even if test is disabled
+        EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+        if (bpmem.zmode.testenable)
+        {
+          // early z
+          if (!EfbInterface::ZCompare(x + xi, y + yi, z))
+          {
+            coverage_mask &= ~(1u << lane);
+            continue;
+          }
+        }
+        EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+      }
+
+      const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+
+      tev.Position[lane][0] = x + xi;
+      tev.Position[lane][1] = y + yi;
+      tev.Position[lane][2] = z;
+
+      //  colors
+      for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
+      {
+        for (int comp = 0; comp < 4; comp++)
+        {
+          u16 color = (u16)triangle.ColorSlopes[i][comp].GetValue(dx, dy);
+
+          // clamp color value to 0
+          u16 mask = ~(color >> 8);
 
-      // clamp color value to 0
-      u16 mask = ~(color >> 8);
+          tev.Color[lane][i][comp] = color & mask;
+        }
+      }
 
-      tev.Color[i][comp] = color & mask;
+      // tex coords
+      for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
+      {
+        // multiply by 128 because TEV stores UVs as s17.7
+        tev.Uv[lane][i].s = (s32)(pixel.Uv[i][0] * 128);
+        tev.Uv[lane][i].t = (s32)(pixel.Uv[i][1] * 128);
+      }
     }
   }
 
-  // tex coords
-  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
-  {
-    // multiply by 128 because TEV stores UVs as s17.7
-    tev.Uv[i].s = (s32)(pixel.Uv[i][0] * 128);
-    tev.Uv[i].t = (s32)(pixel.Uv[i][1] * 128);
-  }
+  if (coverage_mask == 0)
+    return;
 
   for (unsigned int i = 0; i < bpmem.genMode.numindstages; i++)
   {
@@ -134,19 +246,30 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     tev.TextureLinear[i] = rasterBlock.TextureLinear[i];
   }
 
-  tev.Draw();
+  if (g_ActiveConfig.bDumpTevStages || g_ActiveConfig.bDumpTevTextureFetches)
+  {
+    // The debug dumps keep a single pixel's intermediate values, so shade one lane at a time.
+    for (u32 lane = 0; lane < Tev::NUM_LANES; lane++)
+    {
+      if (coverage_mask & (1u << lane))
+        tev.Draw(1u << lane);
+    }
+    return;
+  }
+
+  tev.Draw(coverage_mask);
 }
 
-static void InitTriangle(float X1, float Y1, s32 xi, s32 yi)
+static void InitTriangle(TriangleSetup* triangle, float X1, float Y1, s32 xi, s32 yi)
 {
-  vertex0X = xi;
-  vertex0Y = yi;
+  triangle->vertex0X = xi;
+  triangle->vertex0Y = yi;
 
   // adjust a little less than 0.5
   const float adjust = 0.495f;
 
-  vertexOffsetX = ((float)xi - X1) + adjust;
-  vertexOffsetY = ((float)yi - Y1) + adjust;
+  triangle->vertexOffsetX = ((float)xi - X1) + adjust;
+  triangle->vertexOffsetY = ((float)yi - Y1) + adjust;
 }
 
 static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, float DX12,
@@ -162,7 +285,8 @@ static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, fl
   slope->f0 = f1;
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
@@ -175,17 +299,17 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   float sDelta, tDelta;
   if (tm0.diag_lod == LODType::Diagonal)
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
 
     sDelta = fabsf(uv0[0] - uv1[0]);
     tDelta = fabsf(uv0[1] - uv1[1]);
   }
   else
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
-    float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
+    const float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
     sDelta = std::max(fabsf(uv0[0] - uv1[0]), fabsf(uv0[0] - uv2[0]));
     tDelta = std::max(fabsf(uv0[1] - uv1[1]), fabsf(uv0[1] - uv2[1]));
@@ -211,30 +335,33 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterContext& context, s32 blockX, s32 blockY)
 {
+  const TriangleSetup& triangle = *context.triangle;
+  RasterBlock& rasterBlock = context.rasterBlock;
+
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
     for (s32 xi = 0; xi < BLOCK_SIZE; xi++)
     {
       RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
-      float dx = vertexOffsetX + (float)(xi + blockX - vertex0X);
-      float dy = vertexOffsetY + (float)(yi + blockY - vertex0Y);
+      float dx = triangle.vertexOffsetX + (float)(xi + blockX - triangle.vertex0X);
+      float dy = triangle.vertexOffsetY + (float)(yi + blockY - triangle.vertex0Y);
 
-      float invW = 1.0f / WSlope.GetValue(dx, dy);
+      float invW = 1.0f / triangle.WSlope.GetValue(dx, dy);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(dx, dy) * invW;
+        float q = triangle.TexSlopes[i][2].GetValue(dx, dy) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(dx, dy) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(dx, dy) * projection;
+        pixel.Uv[i][0] = triangle.TexSlopes[i][0].GetValue(dx, dy) * projection;
+        pixel.Uv[i][1] = triangle.TexSlopes[i][1].GetValue(dx, dy) * projection;
       }
     }
   }
@@ -247,7 +374,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texcoord = indref & 3;
     indref >>= 3;
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -259,16 +387,16 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
 
-void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                           const OutputVertexData* v2)
+// Returns false if the triangle doesn't cover any pixels inside the scissor rectangle.
+static bool SetupTriangle(TriangleSetup* triangle, const OutputVertexData* v0,
+                          const OutputVertexData* v1, const OutputVertexData* v2)
 {
-  INCSTAT(g_stats.this_frame.num_triangles_drawn);
-
   // adapted from http://devmaster.net/posts/6145/advanced-rasterization
 
   // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
@@ -290,15 +418,6 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -331,7 +450,7 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   maxy = std::min(maxy, scissorBottom);
 
   if (minx >= maxx || miny >= maxy)
-    return;
+    return false;
 
   // Setup slopes
   float fltx1 = v0->screenPosition.x;
@@ -341,11 +460,11 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   float fltdy12 = flty1 - v1->screenPosition.y;
   float fltdy31 = v2->screenPosition.y - flty1;
 
-  InitTriangle(fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
+  InitTriangle(triangle, fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
 
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  InitSlope(&WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+  InitSlope(&triangle->WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
 
   // TODO: The zfreeze emulation is not quite correct, yet!
   // Many things might prevent us from reaching this line (culling, clipping, scissoring).
@@ -354,21 +473,29 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   // We're currently sloppy at this since we abort early if any of the culling/clipping/scissoring
   // tests fail.
   if (!bpmem.genMode.zfreeze || !g_ActiveConfig.bZFreeze)
+  {
     InitSlope(&ZSlope, v0->screenPosition[2], v1->screenPosition[2], v2->screenPosition[2], fltdx31,
               fltdx12, fltdy12, fltdy31);
+  }
+  triangle->ZSlope = ZSlope;
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      InitSlope(&ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp], v2->color[i][comp],
-                fltdx31, fltdx12, fltdy12, fltdy31);
+    {
+      InitSlope(&triangle->ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp],
+                v2->color[i][comp], fltdx31, fltdx12, fltdy12, fltdy31);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
-      InitSlope(&TexSlopes[i][comp], v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                v2->texCoords[i][comp] * w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+    {
+      InitSlope(&triangle->TexSlopes[i][comp], v0->texCoords[i][comp] * w[0],
+                v1->texCoords[i][comp] * w[1], v2->texCoords[i][comp] * w[2], fltdx31, fltdx12,
+                fltdy12, fltdy31);
+    }
   }
 
   // Half-edge constants
@@ -384,9 +511,53 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  triangle->C1 = C1;
+  triangle->C2 = C2;
+  triangle->C3 = C3;
+  triangle->DX12 = DX12;
+  triangle->DX23 = DX23;
+  triangle->DX31 = DX31;
+  triangle->DY12 = DY12;
+  triangle->DY23 = DY23;
+  triangle->DY31 = DY31;
+
   // Start in corner of 8x8 block
-  minx &= ~(BLOCK_SIZE - 1);
-  miny &= ~(BLOCK_SIZE - 1);
+  triangle->minx = minx & ~(BLOCK_SIZE - 1);
+  triangle->miny = miny & ~(BLOCK_SIZE - 1);
+  triangle->maxx = maxx;
+  triangle->maxy = maxy;
+
+  return true;
+}
+
+// Rasterizes the part of the context's triangle whose blocks start inside the given rectangle.
+static void RasterizeTriangle(RasterContext& context, s32 left, s32 top, s32 right, s32 bottom)
+{
+  const TriangleSetup& triangle = *context.triangle;
+
+  const s32 C1 = triangle.C1;
+  const s32 C2 = triangle.C2;
+  const s32 C3 = triangle.C3;
+  const s32 DX12 = triangle.DX12;
+  const s32 DX23 = triangle.DX23;
+  const s32 DX31 = triangle.DX31;
+  const s32 DY12 = triangle.DY12;
+  const s32 DY23 = triangle.DY23;
+  const s32 DY31 = triangle.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  const s32 minx = std::max(triangle.minx, left);
+  const s32 miny = std::max(triangle.miny, top);
+  const s32 maxx = std::min(triangle.maxx, right);
+  const s32 maxy = std::min(triangle.maxy, bottom);
 
   // Loop through blocks
   for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
@@ -422,18 +593,12 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context, x, y);
 
       // Accept whole block when totally covered
       if (a == 0xF && b == 0xF && c == 0xF)
       {
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-        {
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-          {
-            Draw(x + ix, y + iy, ix, iy);
-          }
-        }
+        Draw(context, x, y, (1u << Tev::NUM_LANES) - 1);
       }
       else  // Partially covered block
       {
@@ -441,6 +606,7 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
         s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
         s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
 
+        u32 coverage_mask = 0;
         for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
         {
           s32 CX1 = CY1;
@@ -450,9 +616,7 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
             if (CX1 > 0 && CX2 > 0 && CX3 > 0)
-            {
-              Draw(x + ix, y + iy, ix, iy);
-            }
+              coverage_mask |= 1u << (ix + iy * BLOCK_SIZE);
 
             CX1 -= FDY12;
             CX2 -= FDY23;
@@ -463,8 +627,139 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
           CY2 += FDX23;
           CY3 += FDX31;
         }
+
+        Draw(context, x, y, coverage_mask);
       }
     }
   }
 }
+
+static void FlushStatistics()
+{
+  for (auto& context : s_contexts)
+  {
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, context->rasterized_pixels);
+    ADDSTAT(g_stats.this_frame.tev_pixels_in, context->tev.PixelsIn);
+    ADDSTAT(g_stats.this_frame.tev_pixels_out, context->tev.PixelsOut);
+    context->rasterized_pixels = 0;
+    context->tev.PixelsIn = 0;
+    context->tev.PixelsOut = 0;
+  }
+}
+
+static void RasterizeTiles(RasterContext& context)
+{
+  for (u32 i = s_next_active_tile++; i < s_active_tiles.size(); i = s_next_active_tile++)
+  {
+    const u32 tile = s_active_tiles[i];
+    const s32 left = static_cast<s32>(tile % NUM_TILES_X) * TILE_SIZE;
+    const s32 top = static_cast<s32>(tile / NUM_TILES_X) * TILE_SIZE;
+
+    for (u32 index : s_bins[tile])
+    {
+      context.triangle = &s_triangles[index];
+      RasterizeTriangle(context, left, top, left + TILE_SIZE, top + TILE_SIZE);
+    }
+  }
+}
+
+static void WorkerThread(RasterContext* context, u32 generation)
+{
+  Common::SetCurrentThreadName("SW rasterizer");
+
+  std::unique_lock lk(s_workers_mutex);
+  while (true)
+  {
+    s_work_available.wait(lk, [&] { return s_workers_exit || s_work_generation != generation; });
+    if (s_workers_exit)
+      return;
+    generation = s_work_generation;
+
+    lk.unlock();
+    RasterizeTiles(*context);
+    lk.lock();
+
+    if (--s_workers_busy == 0)
+      s_work_done.notify_one();
+  }
+}
+
+void Flush()
+{
+  if (!s_triangles.empty())
+  {
+    s_next_active_tile.store(0);
+    {
+      std::lock_guard lk(s_workers_mutex);
+      s_workers_busy = static_cast<u32>(s_workers.size());
+      s_work_generation++;
+    }
+    s_work_available.notify_all();
+
+    RasterizeTiles(*s_contexts[0]);
+
+    {
+      std::unique_lock lk(s_workers_mutex);
+      s_work_done.wait(lk, [] { return s_workers_busy == 0; });
+    }
+
+    for (u32 tile : s_active_tiles)
+      s_bins[tile].clear();
+    s_active_tiles.clear();
+    s_triangles.clear();
+  }
+
+  FlushStatistics();
+}
+
+static bool UseTiles()
+{
+  // Bounding box and the TEV debug dumps are global state updated per pixel.
+  return s_contexts.size() > 1 && !BoundingBox::IsEnabled() && !g_ActiveConfig.bDumpTevStages &&
+         !g_ActiveConfig.bDumpTevTextureFetches;
+}
+
+void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
+                           const OutputVertexData* v2)
+{
+  INCSTAT(g_stats.this_frame.num_triangles_drawn);
+
+  if (!UseTiles())
+  {
+    // Triangles must still be drawn in order.
+    Flush();
+
+    TriangleSetup triangle;
+    if (!SetupTriangle(&triangle, v0, v1, v2))
+      return;
+
+    RasterContext& context = *s_contexts[0];
+    context.triangle = &triangle;
+    RasterizeTriangle(context, 0, 0, EFB_WIDTH, EFB_HEIGHT);
+    return;
+  }
+
+  TriangleSetup& triangle = s_triangles.emplace_back();
+  if (!SetupTriangle(&triangle, v0, v1, v2))
+  {
+    s_triangles.pop_back();
+    return;
+  }
+
+  const u32 index = static_cast<u32>(s_triangles.size() - 1);
+  const s32 tile_left = triangle.minx / TILE_SIZE;
+  const s32 tile_top = triangle.miny / TILE_SIZE;
+  const s32 tile_right = (triangle.maxx - 1) / TILE_SIZE;
+  const s32 tile_bottom = (triangle.maxy - 1) / TILE_SIZE;
+  for (s32 tile_y = tile_top; tile_y <= tile_bottom; tile_y++)
+  {
+    for (s32 tile_x = tile_left; tile_x <= tile_right; tile_x++)
+    {
+      const u32 tile = static_cast<u32>(tile_y * NUM_TILES_X + tile_x);
+      if (s_bins[tile].empty())
+        s_active_tiles.push_back(tile);
+      s_bins[tile].push_back(index);
+    }
+  }
+}
 }  // namespace Rasterizer
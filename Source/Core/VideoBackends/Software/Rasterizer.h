@@ -11,9 +11,13 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 
+// Triangles may be queued and rasterized by multiple threads. They must be flushed before any
+// state they depend on changes, or before the EFB is accessed.
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+void Flush();
 
 void SetTevReg(int reg, int comp, s16 color);
 
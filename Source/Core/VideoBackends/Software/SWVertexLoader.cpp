@@ -16,6 +16,7 @@
 #include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/SWRenderer.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoBackends/Software/TransformUnit.h"
 
 #include "VideoCommon/CPMemory.h"
@@ -55,6 +56,7 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
   }
 
   m_setup_unit.Init(primitiveType);
+  TextureSampler::PrepareTextures();
 
   // set all states with are stored within video sw
   for (int i = 0; i < 4; i++)
@@ -65,26 +67,14 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     Rasterizer::SetTevReg(i, Tev::ALP_C, PixelShaderManager::constants.kcolors[i][3]);
   }
 
+  TransformVertices(primitiveType);
+
   for (u32 i = 0; i < m_index_generator.GetIndexLen(); i++)
   {
     const u16 index = m_cpu_index_buffer[i];
-    memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
-
-    // parse the videocommon format to our own struct format (m_vertex)
-    SetFormat(g_main_cp_state.last_id, primitiveType);
-    ParseVertex(VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration(), index);
 
-    // transform this vertex so that it can be used for rasterization (outVertex)
-    OutputVertexData* outVertex = m_setup_unit.GetVertex();
-    TransformUnit::TransformPosition(&m_vertex, outVertex);
-    outVertex->normal = {};
-    if (VertexLoaderManager::g_current_components & VB_HAS_NRM0)
-    {
-      TransformUnit::TransformNormal(
-          &m_vertex, (VertexLoaderManager::g_current_components & VB_HAS_NRM2) != 0, outVertex);
-    }
-    TransformUnit::TransformColor(&m_vertex, outVertex);
-    TransformUnit::TransformTexCoord(&m_vertex, outVertex);
+    // Shared vertices of strips and fans were only transformed once.
+    *m_setup_unit.GetVertex() = m_output_vertices[m_transformed_index[index]];
 
     // assemble and rasterize the primitive
     m_setup_unit.SetupVertex();
@@ -92,9 +82,64 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     INCSTAT(g_stats.this_frame.num_vertices_loaded)
   }
 
+  // BP state changes always end a batch, so this is the last point where the queued triangles'
+  // state is still current.
+  Rasterizer::Flush();
+
   DebugUtil::OnObjectEnd();
 }
 
+void SWVertexLoader::TransformVertices(u8 primitive_type)
+{
+  // XF state can't change within a batch, so a vertex transforms the same way every time it is
+  // referenced.
+  constexpr u32 NOT_TRANSFORMED = std::numeric_limits<u32>::max();
+  const u32 num_indices = m_index_generator.GetIndexLen();
+  for (const u16 index : m_unique_indices)
+    m_transformed_index[index] = NOT_TRANSFORMED;
+  m_unique_indices.clear();
+  for (u32 i = 0; i < num_indices; i++)
+  {
+    const u16 index = m_cpu_index_buffer[i];
+    if (index >= m_transformed_index.size())
+      m_transformed_index.resize(index + 1, NOT_TRANSFORMED);
+    if (m_transformed_index[index] != NOT_TRANSFORMED)
+      continue;
+
+    m_transformed_index[index] = static_cast<u32>(m_unique_indices.size());
+    m_unique_indices.push_back(index);
+  }
+
+  // parse the videocommon format to our own struct format
+  const size_t num_vertices = m_unique_indices.size();
+  m_input_vertices.resize(num_vertices);
+  const PortableVertexDeclaration& vdec =
+      VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration();
+  for (size_t i = 0; i < num_vertices; i++)
+  {
+    memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
+    SetFormat(g_main_cp_state.last_id, primitive_type);
+    ParseVertex(vdec, m_unique_indices[i]);
+    m_input_vertices[i] = m_vertex;
+  }
+
+  // transform the vertices so that they can be used for rasterization
+  m_output_vertices.assign(num_vertices, OutputVertexData{});
+  TransformUnit::TransformPositions(m_input_vertices.data(), m_output_vertices.data(),
+                                    num_vertices);
+  if (VertexLoaderManager::g_current_components & VB_HAS_NRM0)
+  {
+    TransformUnit::TransformNormals(m_input_vertices.data(),
+                                    (VertexLoaderManager::g_current_components & VB_HAS_NRM2) != 0,
+                                    m_output_vertices.data(), num_vertices);
+  }
+  for (size_t i = 0; i < num_vertices; i++)
+  {
+    TransformUnit::TransformColor(&m_input_vertices[i], &m_output_vertices[i]);
+    TransformUnit::TransformTexCoord(&m_input_vertices[i], &m_output_vertices[i]);
+  }
+}
+
 void SWVertexLoader::SetFormat(u8 attributeIndex, u8 primitiveType)
 {
   // matrix index from xf regs or cp memory?
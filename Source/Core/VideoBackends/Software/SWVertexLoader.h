@@ -25,7 +25,15 @@ protected:
 
   void SetFormat(u8 attributeIndex, u8 primitiveType);
   void ParseVertex(const PortableVertexDeclaration& vdec, int index);
+  void TransformVertices(u8 primitive_type);
 
   InputVertexData m_vertex;
   SetupUnit m_setup_unit;
+
+  // Every vertex referenced by the current batch is transformed once, in the order of their first
+  // reference, and the transformed vertices are then looked up by index.
+  std::vector<u32> m_transformed_index;
+  std::vector<u16> m_unique_indices;
+  std::vector<InputVertexData> m_input_vertices;
+  std::vector<OutputVertexData> m_output_vertices;
 };
@@ -21,6 +21,7 @@
 #include "VideoBackends/Software/SWTexture.h"
 #include "VideoBackends/Software/SWVertexLoader.h"
 #include "VideoBackends/Software/TextureCache.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoBackends/Software/VideoBackend.h"
 
 #include "VideoCommon/FramebufferManager.h"
@@ -130,6 +131,8 @@ void VideoSoftware::Shutdown()
     g_renderer->Shutdown();
 
   DebugUtil::Shutdown();
+  Rasterizer::Shutdown();
+  TextureSampler::ClearCache();
   g_texture_cache.reset();
   g_perf_query.reset();
   g_framebuffer_manager.reset();
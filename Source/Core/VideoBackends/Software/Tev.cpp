@@ -8,16 +8,21 @@
 #include <cmath>
 #include <cstring>
 
+#include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "VideoBackends/Software/DebugUtil.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
+#ifdef _M_X86_64
+#include "VideoBackends/Software/TevJit.h"
+#endif
+
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
@@ -28,123 +33,118 @@
 #define ALLOW_TEV_DUMPS 0
 #endif
 
+Tev::Tev() = default;
+Tev::~Tev() = default;
+
 void Tev::Init()
 {
-  FixedConstants[0] = 0;
-  FixedConstants[1] = 32;
-  FixedConstants[2] = 64;
-  FixedConstants[3] = 96;
-  FixedConstants[4] = 128;
-  FixedConstants[5] = 159;
-  FixedConstants[6] = 191;
-  FixedConstants[7] = 223;
-  FixedConstants[8] = 255;
-
-  for (s16& comp : Zero16)
-  {
-    comp = 0;
-  }
-
-  m_ColorInputLUT[0][RED_INP] = &Reg[0][RED_C];
-  m_ColorInputLUT[0][GRN_INP] = &Reg[0][GRN_C];
-  m_ColorInputLUT[0][BLU_INP] = &Reg[0][BLU_C];  // prev.rgb
-  m_ColorInputLUT[1][RED_INP] = &Reg[0][ALP_C];
-  m_ColorInputLUT[1][GRN_INP] = &Reg[0][ALP_C];
-  m_ColorInputLUT[1][BLU_INP] = &Reg[0][ALP_C];  // prev.aaa
-  m_ColorInputLUT[2][RED_INP] = &Reg[1][RED_C];
-  m_ColorInputLUT[2][GRN_INP] = &Reg[1][GRN_C];
-  m_ColorInputLUT[2][BLU_INP] = &Reg[1][BLU_C];  // c0.rgb
-  m_ColorInputLUT[3][RED_INP] = &Reg[1][ALP_C];
-  m_ColorInputLUT[3][GRN_INP] = &Reg[1][ALP_C];
-  m_ColorInputLUT[3][BLU_INP] = &Reg[1][ALP_C];  // c0.aaa
-  m_ColorInputLUT[4][RED_INP] = &Reg[2][RED_C];
-  m_ColorInputLUT[4][GRN_INP] = &Reg[2][GRN_C];
-  m_ColorInputLUT[4][BLU_INP] = &Reg[2][BLU_C];  // c1.rgb
-  m_ColorInputLUT[5][RED_INP] = &Reg[2][ALP_C];
-  m_ColorInputLUT[5][GRN_INP] = &Reg[2][ALP_C];
-  m_ColorInputLUT[5][BLU_INP] = &Reg[2][ALP_C];  // c1.aaa
-  m_ColorInputLUT[6][RED_INP] = &Reg[3][RED_C];
-  m_ColorInputLUT[6][GRN_INP] = &Reg[3][GRN_C];
-  m_ColorInputLUT[6][BLU_INP] = &Reg[3][BLU_C];  // c2.rgb
-  m_ColorInputLUT[7][RED_INP] = &Reg[3][ALP_C];
-  m_ColorInputLUT[7][GRN_INP] = &Reg[3][ALP_C];
-  m_ColorInputLUT[7][BLU_INP] = &Reg[3][ALP_C];  // c2.aaa
-  m_ColorInputLUT[8][RED_INP] = &TexColor[RED_C];
-  m_ColorInputLUT[8][GRN_INP] = &TexColor[GRN_C];
-  m_ColorInputLUT[8][BLU_INP] = &TexColor[BLU_C];  // tex.rgb
-  m_ColorInputLUT[9][RED_INP] = &TexColor[ALP_C];
-  m_ColorInputLUT[9][GRN_INP] = &TexColor[ALP_C];
-  m_ColorInputLUT[9][BLU_INP] = &TexColor[ALP_C];  // tex.aaa
-  m_ColorInputLUT[10][RED_INP] = &RasColor[RED_C];
-  m_ColorInputLUT[10][GRN_INP] = &RasColor[GRN_C];
-  m_ColorInputLUT[10][BLU_INP] = &RasColor[BLU_C];  // ras.rgb
-  m_ColorInputLUT[11][RED_INP] = &RasColor[ALP_C];
-  m_ColorInputLUT[11][GRN_INP] = &RasColor[ALP_C];
-  m_ColorInputLUT[11][BLU_INP] = &RasColor[ALP_C];  // ras.rgb
-  m_ColorInputLUT[12][RED_INP] = &FixedConstants[8];
-  m_ColorInputLUT[12][GRN_INP] = &FixedConstants[8];
-  m_ColorInputLUT[12][BLU_INP] = &FixedConstants[8];  // one
-  m_ColorInputLUT[13][RED_INP] = &FixedConstants[4];
-  m_ColorInputLUT[13][GRN_INP] = &FixedConstants[4];
-  m_ColorInputLUT[13][BLU_INP] = &FixedConstants[4];  // half
-  m_ColorInputLUT[14][RED_INP] = &StageKonst[RED_C];
-  m_ColorInputLUT[14][GRN_INP] = &StageKonst[GRN_C];
-  m_ColorInputLUT[14][BLU_INP] = &StageKonst[BLU_C];  // konst
-  m_ColorInputLUT[15][RED_INP] = &FixedConstants[0];
-  m_ColorInputLUT[15][GRN_INP] = &FixedConstants[0];
-  m_ColorInputLUT[15][BLU_INP] = &FixedConstants[0];  // zero
-
-  m_AlphaInputLUT[0] = &Reg[0][ALP_C];      // prev
-  m_AlphaInputLUT[1] = &Reg[1][ALP_C];      // c0
-  m_AlphaInputLUT[2] = &Reg[2][ALP_C];      // c1
-  m_AlphaInputLUT[3] = &Reg[3][ALP_C];      // c2
-  m_AlphaInputLUT[4] = &TexColor[ALP_C];    // tex
-  m_AlphaInputLUT[5] = &RasColor[ALP_C];    // ras
-  m_AlphaInputLUT[6] = &StageKonst[ALP_C];  // konst
-  m_AlphaInputLUT[7] = &Zero16[ALP_C];      // zero
+  static constexpr s32 fixed_constants[9] = {0, 32, 64, 96, 128, 159, 191, 223, 255};
+  for (int i = 0; i < 9; i++)
+    std::fill_n(FixedConstants[i], NUM_LANES, fixed_constants[i]);
+
+  for (auto& comp : Zero16)
+    std::fill_n(comp, NUM_LANES, 0);
+
+  m_ColorInputLUT[0][RED_INP] = Reg[0][RED_C];
+  m_ColorInputLUT[0][GRN_INP] = Reg[0][GRN_C];
+  m_ColorInputLUT[0][BLU_INP] = Reg[0][BLU_C];  // prev.rgb
+  m_ColorInputLUT[1][RED_INP] = Reg[0][ALP_C];
+  m_ColorInputLUT[1][GRN_INP] = Reg[0][ALP_C];
+  m_ColorInputLUT[1][BLU_INP] = Reg[0][ALP_C];  // prev.aaa
+  m_ColorInputLUT[2][RED_INP] = Reg[1][RED_C];
+  m_ColorInputLUT[2][GRN_INP] = Reg[1][GRN_C];
+  m_ColorInputLUT[2][BLU_INP] = Reg[1][BLU_C];  // c0.rgb
+  m_ColorInputLUT[3][RED_INP] = Reg[1][ALP_C];
+  m_ColorInputLUT[3][GRN_INP] = Reg[1][ALP_C];
+  m_ColorInputLUT[3][BLU_INP] = Reg[1][ALP_C];  // c0.aaa
+  m_ColorInputLUT[4][RED_INP] = Reg[2][RED_C];
+  m_ColorInputLUT[4][GRN_INP] = Reg[2][GRN_C];
+  m_ColorInputLUT[4][BLU_INP] = Reg[2][BLU_C];  // c1.rgb
+  m_ColorInputLUT[5][RED_INP] = Reg[2][ALP_C];
+  m_ColorInputLUT[5][GRN_INP] = Reg[2][ALP_C];
+  m_ColorInputLUT[5][BLU_INP] = Reg[2][ALP_C];  // c1.aaa
+  m_ColorInputLUT[6][RED_INP] = Reg[3][RED_C];
+  m_ColorInputLUT[6][GRN_INP] = Reg[3][GRN_C];
+  m_ColorInputLUT[6][BLU_INP] = Reg[3][BLU_C];  // c2.rgb
+  m_ColorInputLUT[7][RED_INP] = Reg[3][ALP_C];
+  m_ColorInputLUT[7][GRN_INP] = Reg[3][ALP_C];
+  m_ColorInputLUT[7][BLU_INP] = Reg[3][ALP_C];  // c2.aaa
+  m_ColorInputLUT[8][RED_INP] = TexColor[RED_C];
+  m_ColorInputLUT[8][GRN_INP] = TexColor[GRN_C];
+  m_ColorInputLUT[8][BLU_INP] = TexColor[BLU_C];  // tex.rgb
+  m_ColorInputLUT[9][RED_INP] = TexColor[ALP_C];
+  m_ColorInputLUT[9][GRN_INP] = TexColor[ALP_C];
+  m_ColorInputLUT[9][BLU_INP] = TexColor[ALP_C];  // tex.aaa
+  m_ColorInputLUT[10][RED_INP] = RasColor[RED_C];
+  m_ColorInputLUT[10][GRN_INP] = RasColor[GRN_C];
+  m_ColorInputLUT[10][BLU_INP] = RasColor[BLU_C];  // ras.rgb
+  m_ColorInputLUT[11][RED_INP] = RasColor[ALP_C];
+  m_ColorInputLUT[11][GRN_INP] = RasColor[ALP_C];
+  m_ColorInputLUT[11][BLU_INP] = RasColor[ALP_C];  // ras.rgb
+  m_ColorInputLUT[12][RED_INP] = FixedConstants[8];
+  m_ColorInputLUT[12][GRN_INP] = FixedConstants[8];
+  m_ColorInputLUT[12][BLU_INP] = FixedConstants[8];  // one
+  m_ColorInputLUT[13][RED_INP] = FixedConstants[4];
+  m_ColorInputLUT[13][GRN_INP] = FixedConstants[4];
+  m_ColorInputLUT[13][BLU_INP] = FixedConstants[4];  // half
+  m_ColorInputLUT[14][RED_INP] = StageKonst[RED_C];
+  m_ColorInputLUT[14][GRN_INP] = StageKonst[GRN_C];
+  m_ColorInputLUT[14][BLU_INP] = StageKonst[BLU_C];  // konst
+  m_ColorInputLUT[15][RED_INP] = FixedConstants[0];
+  m_ColorInputLUT[15][GRN_INP] = FixedConstants[0];
+  m_ColorInputLUT[15][BLU_INP] = FixedConstants[0];  // zero
+
+  m_AlphaInputLUT[0] = Reg[0][ALP_C];      // prev
+  m_AlphaInputLUT[1] = Reg[1][ALP_C];      // c0
+  m_AlphaInputLUT[2] = Reg[2][ALP_C];      // c1
+  m_AlphaInputLUT[3] = Reg[3][ALP_C];      // c2
+  m_AlphaInputLUT[4] = TexColor[ALP_C];    // tex
+  m_AlphaInputLUT[5] = RasColor[ALP_C];    // ras
+  m_AlphaInputLUT[6] = StageKonst[ALP_C];  // konst
+  m_AlphaInputLUT[7] = Zero16[ALP_C];      // zero
 
   for (int comp = 0; comp < 4; comp++)
   {
-    m_KonstLUT[0][comp] = &FixedConstants[8];
-    m_KonstLUT[1][comp] = &FixedConstants[7];
-    m_KonstLUT[2][comp] = &FixedConstants[6];
-    m_KonstLUT[3][comp] = &FixedConstants[5];
-    m_KonstLUT[4][comp] = &FixedConstants[4];
-    m_KonstLUT[5][comp] = &FixedConstants[3];
-    m_KonstLUT[6][comp] = &FixedConstants[2];
-    m_KonstLUT[7][comp] = &FixedConstants[1];
+    m_KonstLUT[0][comp] = FixedConstants[8];
+    m_KonstLUT[1][comp] = FixedConstants[7];
+    m_KonstLUT[2][comp] = FixedConstants[6];
+    m_KonstLUT[3][comp] = FixedConstants[5];
+    m_KonstLUT[4][comp] = FixedConstants[4];
+    m_KonstLUT[5][comp] = FixedConstants[3];
+    m_KonstLUT[6][comp] = FixedConstants[2];
+    m_KonstLUT[7][comp] = FixedConstants[1];
 
     // These are "invalid" values, not meant to be used. On hardware,
     // they all output zero.
     for (int i = 8; i < 16; ++i)
     {
-      m_KonstLUT[i][comp] = &FixedConstants[0];
+      m_KonstLUT[i][comp] = FixedConstants[0];
     }
 
     if (comp != ALP_C)
     {
-      m_KonstLUT[12][comp] = &KonstantColors[0][comp];
-      m_KonstLUT[13][comp] = &KonstantColors[1][comp];
-      m_KonstLUT[14][comp] = &KonstantColors[2][comp];
-      m_KonstLUT[15][comp] = &KonstantColors[3][comp];
+      m_KonstLUT[12][comp] = KonstantColors[0][comp];
+      m_KonstLUT[13][comp] = KonstantColors[1][comp];
+      m_KonstLUT[14][comp] = KonstantColors[2][comp];
+      m_KonstLUT[15][comp] = KonstantColors[3][comp];
     }
 
-    m_KonstLUT[16][comp] = &KonstantColors[0][RED_C];
-    m_KonstLUT[17][comp] = &KonstantColors[1][RED_C];
-    m_KonstLUT[18][comp] = &KonstantColors[2][RED_C];
-    m_KonstLUT[19][comp] = &KonstantColors[3][RED_C];
-    m_KonstLUT[20][comp] = &KonstantColors[0][GRN_C];
-    m_KonstLUT[21][comp] = &KonstantColors[1][GRN_C];
-    m_KonstLUT[22][comp] = &KonstantColors[2][GRN_C];
-    m_KonstLUT[23][comp] = &KonstantColors[3][GRN_C];
-    m_KonstLUT[24][comp] = &KonstantColors[0][BLU_C];
-    m_KonstLUT[25][comp] = &KonstantColors[1][BLU_C];
-    m_KonstLUT[26][comp] = &KonstantColors[2][BLU_C];
-    m_KonstLUT[27][comp] = &KonstantColors[3][BLU_C];
-    m_KonstLUT[28][comp] = &KonstantColors[0][ALP_C];
-    m_KonstLUT[29][comp] = &KonstantColors[1][ALP_C];
-    m_KonstLUT[30][comp] = &KonstantColors[2][ALP_C];
-    m_KonstLUT[31][comp] = &KonstantColors[3][ALP_C];
+    m_KonstLUT[16][comp] = KonstantColors[0][RED_C];
+    m_KonstLUT[17][comp] = KonstantColors[1][RED_C];
+    m_KonstLUT[18][comp] = KonstantColors[2][RED_C];
+    m_KonstLUT[19][comp] = KonstantColors[3][RED_C];
+    m_KonstLUT[20][comp] = KonstantColors[0][GRN_C];
+    m_KonstLUT[21][comp] = KonstantColors[1][GRN_C];
+    m_KonstLUT[22][comp] = KonstantColors[2][GRN_C];
+    m_KonstLUT[23][comp] = KonstantColors[3][GRN_C];
+    m_KonstLUT[24][comp] = KonstantColors[0][BLU_C];
+    m_KonstLUT[25][comp] = KonstantColors[1][BLU_C];
+    m_KonstLUT[26][comp] = KonstantColors[2][BLU_C];
+    m_KonstLUT[27][comp] = KonstantColors[3][BLU_C];
+    m_KonstLUT[28][comp] = KonstantColors[0][ALP_C];
+    m_KonstLUT[29][comp] = KonstantColors[1][ALP_C];
+    m_KonstLUT[30][comp] = KonstantColors[2][ALP_C];
+    m_KonstLUT[31][comp] = KonstantColors[3][ALP_C];
   }
 
   m_BiasLUT[0] = 0;
@@ -161,56 +161,261 @@ void Tev::Init()
   m_ScaleRShiftLUT[1] = 0;
   m_ScaleRShiftLUT[2] = 0;
   m_ScaleRShiftLUT[3] = 1;
+
+#ifdef _M_X86_64
+  if (g_ActiveConfig.bSWTevJit)
+    m_jit = std::make_unique<TevJit>(*this);
+  else
+    m_jit.reset();
+#endif
+}
+
+namespace
+{
+// The operations the TEV needs on all lanes of a quad, so that the combiner code below is shared
+// between SSE2 and the generic fallback.
+class LaneVector
+{
+public:
+  LaneVector() = default;
+
+#ifdef _M_X86
+  static LaneVector Load(const s32* values)
+  {
+    return LaneVector(_mm_load_si128(reinterpret_cast<const __m128i*>(values)));
+  }
+  static LaneVector Broadcast(s32 value) { return LaneVector(_mm_set1_epi32(value)); }
+
+  void Store(s32* values) const
+  {
+    _mm_store_si128(reinterpret_cast<__m128i*>(values), m_value);
+  }
+
+  // Returns a bit mask of the lanes which have their sign bit set.
+  u32 GetSignMask() const
+  {
+    return static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(m_value)));
+  }
+
+  LaneVector operator+(LaneVector other) const { return _mm_add_epi32(m_value, other.m_value); }
+  LaneVector operator-(LaneVector other) const { return _mm_sub_epi32(m_value, other.m_value); }
+  // Both factors must be in [0, 256] and the product must fit in 16 bits.
+  LaneVector operator*(LaneVector other) const { return _mm_mullo_epi16(m_value, other.m_value); }
+  LaneVector operator&(LaneVector other) const { return _mm_and_si128(m_value, other.m_value); }
+  LaneVector operator|(LaneVector other) const { return _mm_or_si128(m_value, other.m_value); }
+  LaneVector operator^(LaneVector other) const { return _mm_xor_si128(m_value, other.m_value); }
+  LaneVector operator<<(int shift) const
+  {
+    return _mm_sll_epi32(m_value, _mm_cvtsi32_si128(shift));
+  }
+  LaneVector operator>>(int shift) const
+  {
+    return _mm_sra_epi32(m_value, _mm_cvtsi32_si128(shift));
+  }
+
+  // Comparisons return all bits set in the lanes where they hold.
+  LaneVector operator>(LaneVector other) const { return _mm_cmpgt_epi32(m_value, other.m_value); }
+  LaneVector operator==(LaneVector other) const
+  {
+    return _mm_cmpeq_epi32(m_value, other.m_value);
+  }
+
+  static LaneVector Select(LaneVector mask, LaneVector if_set, LaneVector if_clear)
+  {
+    return _mm_or_si128(_mm_and_si128(mask.m_value, if_set.m_value),
+                        _mm_andnot_si128(mask.m_value, if_clear.m_value));
+  }
+
+private:
+  LaneVector(__m128i value) : m_value(value) {}
+
+  __m128i m_value;
+#else
+  static LaneVector Load(const s32* values)
+  {
+    LaneVector result;
+    std::copy_n(values, Tev::NUM_LANES, result.m_lanes);
+    return result;
+  }
+  static LaneVector Broadcast(s32 value)
+  {
+    LaneVector result;
+    std::fill_n(result.m_lanes, Tev::NUM_LANES, value);
+    return result;
+  }
+
+  void Store(s32* values) const { std::copy_n(m_lanes, Tev::NUM_LANES, values); }
+
+  // Returns a bit mask of the lanes which have their sign bit set.
+  u32 GetSignMask() const
+  {
+    u32 result = 0;
+    for (int i = 0; i < Tev::NUM_LANES; i++)
+      result |= (m_lanes[i] < 0 ? 1u : 0u) << i;
+    return result;
+  }
+
+  LaneVector operator+(LaneVector other) const
+  {
+    return Map(other, [](s32 a, s32 b) { return a + b; });
+  }
+  LaneVector operator-(LaneVector other) const
+  {
+    return Map(other, [](s32 a, s32 b) { return a - b; });
+  }
+  LaneVector operator*(LaneVector other) const
+  {
+    return Map(other, [](s32 a, s32 b) { return a * b; });
+  }
+  LaneVector operator&(LaneVector other) const
+  {
+    return Map(other, [](s32 a, s32 b) { return a & b; });
+  }
+  LaneVector operator|(LaneVector other) const
+  {
+    return Map(other, [](s32 a, s32 b) { return a | b; });
+  }
+  LaneVector operator^(LaneVector other) const
+  {
+    return Map(other, [](s32 a, s32 b) { return a ^ b; });
+  }
+  LaneVector operator<<(int shift) const
+  {
+    return Map(*this, [shift](s32 a, s32) { return s32(u32(a) << shift); });
+  }
+  LaneVector operator>>(int shift) const
+  {
+    return Map(*this, [shift](s32 a, s32) { return a >> shift; });
+  }
+
+  // Comparisons return all bits set in the lanes where they hold.
+  LaneVector operator>(LaneVector other) const
+  {
+    return Map(other, [](s32 a, s32 b) { return a > b ? -1 : 0; });
+  }
+  LaneVector operator==(LaneVector other) const
+  {
+    return Map(other, [](s32 a, s32 b) { return a == b ? -1 : 0; });
+  }
+
+  static LaneVector Select(LaneVector mask, LaneVector if_set, LaneVector if_clear)
+  {
+    return (mask & if_set) | ((mask ^ Broadcast(-1)) & if_clear);
+  }
+
+private:
+  template <typename F>
+  LaneVector Map(LaneVector other, F f) const
+  {
+    LaneVector result;
+    for (int i = 0; i < Tev::NUM_LANES; i++)
+      result.m_lanes[i] = f(m_lanes[i], other.m_lanes[i]);
+    return result;
+  }
+
+  s32 m_lanes[Tev::NUM_LANES];
+#endif
+};
+
+LaneVector Clamp(LaneVector v, s32 min, s32 max)
+{
+  const LaneVector min_vector = LaneVector::Broadcast(min);
+  const LaneVector max_vector = LaneVector::Broadcast(max);
+  v = LaneVector::Select(v > max_vector, max_vector, v);
+  return LaneVector::Select(min_vector > v, min_vector, v);
+}
+
+LaneVector Clamp255(LaneVector v)
+{
+  return Clamp(v, 0, 255);
+}
+
+LaneVector Clamp1024(LaneVector v)
+{
+  return Clamp(v, -1024, 1023);
 }
 
-static inline s16 Clamp255(s16 in)
+// The combiner inputs a, b and c are 8 bits wide, d is a signed 11 bit value.
+LaneVector LoadInput8(const s32* values)
 {
-  return in > 255 ? 255 : (in < 0 ? 0 : in);
+  return LaneVector::Load(values) & LaneVector::Broadcast(0xff);
 }
 
-static inline s16 Clamp1024(s16 in)
+LaneVector LoadInput11(const s32* values)
 {
-  return in > 1023 ? 1023 : (in < -1024 ? -1024 : in);
+  return (LaneVector::Load(values) << 21) >> 21;
 }
 
-void Tev::SetRasColor(RasColorChan colorChan, int swaptable)
+// Returns a * (256 - c) + b * c, where c is scaled from [0, 255] to [0, 256].
+LaneVector Lerp(LaneVector a, LaneVector b, LaneVector c)
+{
+  c = c + (c >> 7);
+  return a * (LaneVector::Broadcast(256) - c) + b * c;
+}
+
+// Returns a mask of the lanes where the comparison holds.
+LaneVector Compare(TevComparison comparison, LaneVector a, LaneVector b)
+{
+  return comparison == TevComparison::GT ? a > b : a == b;
+}
+
+template <typename F>
+void ForEachLane(u32 mask, F f)
+{
+  for (int lane = 0; lane < Tev::NUM_LANES; lane++)
+  {
+    if (mask & (1u << lane))
+      f(lane);
+  }
+}
+}  // namespace
+
+struct Tev::InputRegType
+{
+  LaneVector a;
+  LaneVector b;
+  LaneVector c;
+  LaneVector d;
+};
+
+void Tev::SetRasColor(int lane, RasColorChan colorChan, int swaptable)
 {
   switch (colorChan)
   {
   case RasColorChan::Color0:
   {
-    const u8* color = Color[0];
-    RasColor[RED_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[GRN_C] = color[bpmem.tevksel[swaptable].swap2];
+    const u8* color = Color[lane][0];
+    RasColor[RED_C][lane] = color[bpmem.tevksel[swaptable].swap1];
+    RasColor[GRN_C][lane] = color[bpmem.tevksel[swaptable].swap2];
     swaptable++;
-    RasColor[BLU_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[ALP_C] = color[bpmem.tevksel[swaptable].swap2];
+    RasColor[BLU_C][lane] = color[bpmem.tevksel[swaptable].swap1];
+    RasColor[ALP_C][lane] = color[bpmem.tevksel[swaptable].swap2];
   }
   break;
   case RasColorChan::Color1:
   {
-    const u8* color = Color[1];
-    RasColor[RED_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[GRN_C] = color[bpmem.tevksel[swaptable].swap2];
+    const u8* color = Color[lane][1];
+    RasColor[RED_C][lane] = color[bpmem.tevksel[swaptable].swap1];
+    RasColor[GRN_C][lane] = color[bpmem.tevksel[swaptable].swap2];
     swaptable++;
-    RasColor[BLU_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[ALP_C] = color[bpmem.tevksel[swaptable].swap2];
+    RasColor[BLU_C][lane] = color[bpmem.tevksel[swaptable].swap1];
+    RasColor[ALP_C][lane] = color[bpmem.tevksel[swaptable].swap2];
   }
   break;
   case RasColorChan::AlphaBump:
   {
-    for (s16& comp : RasColor)
+    for (auto& comp : RasColor)
     {
-      comp = AlphaBump;
+      comp[lane] = AlphaBump[lane];
     }
   }
   break;
   case RasColorChan::NormalizedAlphaBump:
   {
-    const u8 normalized = AlphaBump | AlphaBump >> 5;
-    for (s16& comp : RasColor)
+    const u8 normalized = AlphaBump[lane] | AlphaBump[lane] >> 5;
+    for (auto& comp : RasColor)
     {
-      comp = normalized;
+      comp[lane] = normalized;
     }
   }
   break;
@@ -219,9 +424,9 @@ void Tev::SetRasColor(RasColorChan colorChan, int swaptable)
     if (colorChan != RasColorChan::Zero)
       PanicAlertFmt("Invalid ras color channel: {}", colorChan);
 
-    for (s16& comp : RasColor)
+    for (auto& comp : RasColor)
     {
-      comp = 0;
+      comp[lane] = 0;
     }
   }
   break;
@@ -230,24 +435,22 @@ void Tev::SetRasColor(RasColorChan colorChan, int swaptable)
 
 void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
 {
+  const LaneVector bias = LaneVector::Broadcast(m_BiasLUT[u32(cc.bias.Value())]);
+  const LaneVector round = LaneVector::Broadcast(
+      (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128);
+  const u8 lshift = m_ScaleLShiftLUT[u32(cc.scale.Value())];
+  const u8 rshift = m_ScaleRShiftLUT[u32(cc.scale.Value())];
+
   for (int i = BLU_C; i <= RED_C; i++)
   {
     const InputRegType& InputReg = inputs[i];
 
-    const u16 c = InputReg.c + (InputReg.c >> 7);
+    LaneVector temp = Lerp(InputReg.a, InputReg.b, InputReg.c) << lshift;
+    temp = (temp + round) >> 8;
+    temp = cc.op == TevOp::Sub ? LaneVector::Broadcast(0) - temp : temp;
 
-    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-    temp <<= m_ScaleLShiftLUT[u32(cc.scale.Value())];
-    temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
-    temp >>= 8;
-    temp = cc.op == TevOp::Sub ? -temp : temp;
-
-    s32 result = ((InputReg.d + m_BiasLUT[u32(cc.bias.Value())])
-                  << m_ScaleLShiftLUT[u32(cc.scale.Value())]) +
-                 temp;
-    result = result >> m_ScaleRShiftLUT[u32(cc.scale.Value())];
-
-    Reg[u32(cc.dest.Value())][i] = result;
+    const LaneVector result = (((InputReg.d + bias) << lshift) + temp) >> rshift;
+    result.Store(Reg[u32(cc.dest.Value())][i]);
   }
 }
 
@@ -255,7 +458,7 @@ void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const Inpu
 {
   for (int i = BLU_C; i <= RED_C; i++)
   {
-    u32 a, b;
+    LaneVector a, b;
     switch (cc.compare_mode)
     {
     case TevCompareMode::R8:
@@ -283,10 +486,8 @@ void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const Inpu
       continue;
     }
 
-    if (cc.comparison == TevComparison::GT)
-      Reg[u32(cc.dest.Value())][i] = inputs[i].d + ((a > b) ? inputs[i].c : 0);
-    else
-      Reg[u32(cc.dest.Value())][i] = inputs[i].d + ((a == b) ? inputs[i].c : 0);
+    const LaneVector result = inputs[i].d + (Compare(cc.comparison, a, b) & inputs[i].c);
+    result.Store(Reg[u32(cc.dest.Value())][i]);
   }
 }
 
@@ -294,24 +495,23 @@ void Tev::DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const Inpu
 {
   const InputRegType& InputReg = inputs[ALP_C];
 
-  const u16 c = InputReg.c + (InputReg.c >> 7);
+  const LaneVector bias = LaneVector::Broadcast(m_BiasLUT[u32(ac.bias.Value())]);
+  const LaneVector round = LaneVector::Broadcast(
+      (ac.scale != TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128);
+  const u8 lshift = m_ScaleLShiftLUT[u32(ac.scale.Value())];
+  const u8 rshift = m_ScaleRShiftLUT[u32(ac.scale.Value())];
 
-  s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-  temp <<= m_ScaleLShiftLUT[u32(ac.scale.Value())];
-  temp += (ac.scale != TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
-  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
+  LaneVector temp = Lerp(InputReg.a, InputReg.b, InputReg.c) << lshift;
+  temp = temp + round;
+  temp = ac.op == TevOp::Sub ? (LaneVector::Broadcast(0) - temp) >> 8 : temp >> 8;
 
-  s32 result =
-      ((InputReg.d + m_BiasLUT[u32(ac.bias.Value())]) << m_ScaleLShiftLUT[u32(ac.scale.Value())]) +
-      temp;
-  result = result >> m_ScaleRShiftLUT[u32(ac.scale.Value())];
-
-  Reg[u32(ac.dest.Value())][ALP_C] = result;
+  const LaneVector result = (((InputReg.d + bias) << lshift) + temp) >> rshift;
+  result.Store(Reg[u32(ac.dest.Value())][ALP_C]);
 }
 
 void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
 {
-  u32 a, b;
+  LaneVector a, b;
   switch (ac.compare_mode)
   {
   case TevCompareMode::R8:
@@ -339,56 +539,59 @@ void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const Inpu
     return;
   }
 
-  if (ac.comparison == TevComparison::GT)
-    Reg[u32(ac.dest.Value())][ALP_C] = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
-  else
-    Reg[u32(ac.dest.Value())][ALP_C] = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
+  const LaneVector result = inputs[ALP_C].d + (Compare(ac.comparison, a, b) & inputs[ALP_C].c);
+  result.Store(Reg[u32(ac.dest.Value())][ALP_C]);
 }
 
-static bool AlphaCompare(int alpha, int ref, CompareMode comp)
+// Returns a mask of the lanes that pass.
+static LaneVector AlphaCompare(LaneVector alpha, int ref, CompareMode comp)
 {
+  const LaneVector ref_vector = LaneVector::Broadcast(ref);
+  const LaneVector all = LaneVector::Broadcast(-1);
+
   switch (comp)
   {
   case CompareMode::Always:
-    return true;
+    return all;
   case CompareMode::Never:
-    return false;
+    return LaneVector::Broadcast(0);
   case CompareMode::LEqual:
-    return alpha <= ref;
+    return (alpha > ref_vector) ^ all;
   case CompareMode::Less:
-    return alpha < ref;
+    return ref_vector > alpha;
   case CompareMode::GEqual:
-    return alpha >= ref;
+    return (ref_vector > alpha) ^ all;
   case CompareMode::Greater:
-    return alpha > ref;
+    return alpha > ref_vector;
   case CompareMode::Equal:
-    return alpha == ref;
+    return alpha == ref_vector;
   case CompareMode::NEqual:
-    return alpha != ref;
+    return (alpha == ref_vector) ^ all;
   default:
     PanicAlertFmt("Invalid compare mode {}", comp);
-    return true;
+    return all;
   }
 }
 
-static bool TevAlphaTest(int alpha)
+// Returns the lanes that pass as a bit mask.
+static u32 TevAlphaTest(LaneVector alpha)
 {
-  const bool comp0 = AlphaCompare(alpha, bpmem.alpha_test.ref0, bpmem.alpha_test.comp0);
-  const bool comp1 = AlphaCompare(alpha, bpmem.alpha_test.ref1, bpmem.alpha_test.comp1);
+  const LaneVector comp0 = AlphaCompare(alpha, bpmem.alpha_test.ref0, bpmem.alpha_test.comp0);
+  const LaneVector comp1 = AlphaCompare(alpha, bpmem.alpha_test.ref1, bpmem.alpha_test.comp1);
 
   switch (bpmem.alpha_test.logic)
   {
   case AlphaTestOp::And:
-    return comp0 && comp1;
+    return (comp0 & comp1).GetSignMask();
   case AlphaTestOp::Or:
-    return comp0 || comp1;
+    return (comp0 | comp1).GetSignMask();
   case AlphaTestOp::Xor:
-    return comp0 ^ comp1;
+    return (comp0 ^ comp1).GetSignMask();
   case AlphaTestOp::Xnor:
-    return !(comp0 ^ comp1);
+    return (comp0 ^ comp1 ^ LaneVector::Broadcast(-1)).GetSignMask();
   default:
     PanicAlertFmt("Invalid AlphaTestOp {}", bpmem.alpha_test.logic);
-    return true;
+    return (1u << Tev::NUM_LANES) - 1;
   }
 }
 
@@ -416,10 +619,10 @@ static inline s32 WrapIndirectCoord(s32 coord, IndTexWrap wrapMode)
   }
 }
 
-void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
+void Tev::Indirect(int lane, unsigned int stageNum, s32 s, s32 t)
 {
   const TevStageIndirect& indirect = bpmem.tevind[stageNum];
-  const u8* indmap = IndirectTex[indirect.bt];
+  const u8* indmap = IndirectTex[lane][indirect.bt];
 
   s32 indcoord[3];
 
@@ -427,16 +630,16 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   switch (indirect.bs)
   {
   case IndTexBumpAlpha::Off:
-    AlphaBump = 0;
+    AlphaBump[lane] = 0;
     break;
   case IndTexBumpAlpha::S:
-    AlphaBump = indmap[TextureSampler::ALP_SMP];
+    AlphaBump[lane] = indmap[TextureSampler::ALP_SMP];
     break;
   case IndTexBumpAlpha::T:
-    AlphaBump = indmap[TextureSampler::BLU_SMP];
+    AlphaBump[lane] = indmap[TextureSampler::BLU_SMP];
     break;
   case IndTexBumpAlpha::U:
-    AlphaBump = indmap[TextureSampler::GRN_SMP];
+    AlphaBump[lane] = indmap[TextureSampler::GRN_SMP];
     break;
   default:
     PanicAlertFmt("Invalid alpha bump {}", indirect.bs);
@@ -457,25 +660,25 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
     indcoord[0] = indmap[TextureSampler::ALP_SMP] + bias[0];
     indcoord[1] = indmap[TextureSampler::BLU_SMP] + bias[1];
     indcoord[2] = indmap[TextureSampler::GRN_SMP] + bias[2];
-    AlphaBump = AlphaBump & 0xf8;
+    AlphaBump[lane] = AlphaBump[lane] & 0xf8;
     break;
   case IndTexFormat::ITF_5:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] & 0x1f) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] & 0x1f) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] & 0x1f) + bias[2];
-    AlphaBump = AlphaBump & 0xe0;
+    AlphaBump[lane] = AlphaBump[lane] & 0xe0;
     break;
   case IndTexFormat::ITF_4:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] & 0x0f) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] & 0x0f) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] & 0x0f) + bias[2];
-    AlphaBump = AlphaBump & 0xf0;
+    AlphaBump[lane] = AlphaBump[lane] & 0xf0;
     break;
   case IndTexFormat::ITF_3:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] & 0x07) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] & 0x07) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] & 0x07) + bias[2];
-    AlphaBump = AlphaBump & 0xf8;
+    AlphaBump[lane] = AlphaBump[lane] & 0xf8;
     break;
   default:
     PanicAlertFmt("Invalid indirect format {}", indirect.fmt);
@@ -529,30 +732,66 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
 
   if (indirect.fb_addprev)
   {
-    TexCoord.s += (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
-    TexCoord.t += (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
+    TexCoord[lane].s += (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
+    TexCoord[lane].t += (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
   }
   else
   {
-    TexCoord.s = (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
-    TexCoord.t = (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
+    TexCoord[lane].s = (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
+    TexCoord[lane].t = (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
   }
 }
 
-void Tev::Draw()
+void Tev::DrawCombiners(const TevStageCombiner::ColorCombiner& cc,
+                        const TevStageCombiner::AlphaCombiner& ac)
 {
-  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
-  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
+  // combine inputs
+  InputRegType inputs[4];
+  for (int i = 0; i < 3; i++)
+  {
+    inputs[BLU_C + i].a = LoadInput8(m_ColorInputLUT[u32(cc.a.Value())][i]);
+    inputs[BLU_C + i].b = LoadInput8(m_ColorInputLUT[u32(cc.b.Value())][i]);
+    inputs[BLU_C + i].c = LoadInput8(m_ColorInputLUT[u32(cc.c.Value())][i]);
+    inputs[BLU_C + i].d = LoadInput11(m_ColorInputLUT[u32(cc.d.Value())][i]);
+  }
+  inputs[ALP_C].a = LoadInput8(m_AlphaInputLUT[u32(ac.a.Value())]);
+  inputs[ALP_C].b = LoadInput8(m_AlphaInputLUT[u32(ac.b.Value())]);
+  inputs[ALP_C].c = LoadInput8(m_AlphaInputLUT[u32(ac.c.Value())]);
+  inputs[ALP_C].d = LoadInput11(m_AlphaInputLUT[u32(ac.d.Value())]);
+
+  if (cc.bias != TevBias::Compare)
+    DrawColorRegular(cc, inputs);
+  else
+    DrawColorCompare(cc, inputs);
+
+  auto& color_dest = Reg[u32(cc.dest.Value())];
+  for (int i = BLU_C; i <= RED_C; i++)
+  {
+    const LaneVector color = LaneVector::Load(color_dest[i]);
+    (cc.clamp ? Clamp255(color) : Clamp1024(color)).Store(color_dest[i]);
+  }
+
+  if (ac.bias != TevBias::Compare)
+    DrawAlphaRegular(ac, inputs);
+  else
+    DrawAlphaCompare(ac, inputs);
+
+  s32* alpha_dest = Reg[u32(ac.dest.Value())][ALP_C];
+  const LaneVector alpha = LaneVector::Load(alpha_dest);
+  (ac.clamp ? Clamp255(alpha) : Clamp1024(alpha)).Store(alpha_dest);
+}
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+void Tev::Draw(u32 coverage_mask)
+{
+  PixelsIn += Common::CountSetBits(coverage_mask);
 
   // initial color values
   for (int i = 0; i < 4; i++)
   {
-    Reg[i][RED_C] = PixelShaderManager::constants.colors[i][0];
-    Reg[i][GRN_C] = PixelShaderManager::constants.colors[i][1];
-    Reg[i][BLU_C] = PixelShaderManager::constants.colors[i][2];
-    Reg[i][ALP_C] = PixelShaderManager::constants.colors[i][3];
+    std::fill_n(Reg[i][RED_C], NUM_LANES, s16(PixelShaderManager::constants.colors[i][0]));
+    std::fill_n(Reg[i][GRN_C], NUM_LANES, s16(PixelShaderManager::constants.colors[i][1]));
+    std::fill_n(Reg[i][BLU_C], NUM_LANES, s16(PixelShaderManager::constants.colors[i][2]));
+    std::fill_n(Reg[i][ALP_C], NUM_LANES, s16(PixelShaderManager::constants.colors[i][3]));
   }
 
   for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
@@ -574,19 +813,21 @@ void Tev::Draw()
     const s32 scaleS = stageOdd ? texscale.ss1 : texscale.ss0;
     const s32 scaleT = stageOdd ? texscale.ts1 : texscale.ts0;
 
-    TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
-                           IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
+    ForEachLane(coverage_mask, [&](int lane) {
+      TextureSampler::Sample(Uv[lane][texcoordSel].s >> scaleS, Uv[lane][texcoordSel].t >> scaleT,
+                             IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
+                             IndirectTex[lane][stageNum]);
 
 #if ALLOW_TEV_DUMPS
-    if (g_ActiveConfig.bDumpTevStages)
-    {
-      u8 stage[4] = {IndirectTex[stageNum][TextureSampler::ALP_SMP],
-                     IndirectTex[stageNum][TextureSampler::BLU_SMP],
-                     IndirectTex[stageNum][TextureSampler::GRN_SMP], 255};
-      DebugUtil::DrawTempBuffer(stage, INDIRECT + stageNum);
-    }
+      if (g_ActiveConfig.bDumpTevStages)
+      {
+        u8 stage[4] = {IndirectTex[lane][stageNum][TextureSampler::ALP_SMP],
+                       IndirectTex[lane][stageNum][TextureSampler::BLU_SMP],
+                       IndirectTex[lane][stageNum][TextureSampler::GRN_SMP], 255};
+        DebugUtil::DrawTempBuffer(stage, INDIRECT + stageNum);
+      }
 #endif
+    });
   }
 
   for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
@@ -608,98 +849,69 @@ void Tev::Draw()
     if (texcoordSel >= bpmem.genMode.numtexgens)
       texcoordSel = 0;
 
-    Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
-
-    // sample texture
-    if (order.getEnable(stageOdd))
-    {
-      // RGBA
-      u8 texel[4];
+    // Texture lookups can't be vectorized, so everything up to the combiners runs per lane.
+    ForEachLane(coverage_mask, [&](int lane) {
+      Indirect(lane, stageNum, Uv[lane][texcoordSel].s, Uv[lane][texcoordSel].t);
 
-      if (bpmem.genMode.numtexgens > 0)
-      {
-        TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
-      }
-      else
+      // sample texture
+      if (order.getEnable(stageOdd))
       {
-        // It seems like the result is always black when no tex coords are enabled, but further
-        // hardware testing is needed.
-        std::memset(texel, 0, 4);
-      }
+        // RGBA
+        u8 texel[4];
+
+        if (bpmem.genMode.numtexgens > 0)
+        {
+          TextureSampler::Sample(TexCoord[lane].s, TexCoord[lane].t, TextureLod[stageNum],
+                                 TextureLinear[stageNum], texmap, texel);
+        }
+        else
+        {
+          // It seems like the result is always black when no tex coords are enabled, but further
+          // hardware testing is needed.
+          std::memset(texel, 0, 4);
+        }
 
 #if ALLOW_TEV_DUMPS
-      if (g_ActiveConfig.bDumpTevTextureFetches)
-        DebugUtil::DrawTempBuffer(texel, DIRECT_TFETCH + stageNum);
+        if (g_ActiveConfig.bDumpTevTextureFetches)
+          DebugUtil::DrawTempBuffer(texel, DIRECT_TFETCH + stageNum);
 #endif
 
-      int swaptable = ac.tswap * 2;
+        int swaptable = ac.tswap * 2;
 
-      TexColor[RED_C] = texel[bpmem.tevksel[swaptable].swap1];
-      TexColor[GRN_C] = texel[bpmem.tevksel[swaptable].swap2];
-      swaptable++;
-      TexColor[BLU_C] = texel[bpmem.tevksel[swaptable].swap1];
-      TexColor[ALP_C] = texel[bpmem.tevksel[swaptable].swap2];
-    }
+        TexColor[RED_C][lane] = texel[bpmem.tevksel[swaptable].swap1];
+        TexColor[GRN_C][lane] = texel[bpmem.tevksel[swaptable].swap2];
+        swaptable++;
+        TexColor[BLU_C][lane] = texel[bpmem.tevksel[swaptable].swap1];
+        TexColor[ALP_C][lane] = texel[bpmem.tevksel[swaptable].swap2];
+      }
+
+      // set color
+      SetRasColor(lane, order.getColorChan(stageOdd), ac.rswap * 2);
+    });
 
     // set konst for this stage
     const auto kc = u32(kSel.getKC(stageOdd));
     const auto ka = u32(kSel.getKA(stageOdd));
-    StageKonst[RED_C] = *(m_KonstLUT[kc][RED_C]);
-    StageKonst[GRN_C] = *(m_KonstLUT[kc][GRN_C]);
-    StageKonst[BLU_C] = *(m_KonstLUT[kc][BLU_C]);
-    StageKonst[ALP_C] = *(m_KonstLUT[ka][ALP_C]);
-
-    // set color
-    SetRasColor(order.getColorChan(stageOdd), ac.rswap * 2);
-
-    // combine inputs
-    InputRegType inputs[4];
-    for (int i = 0; i < 3; i++)
-    {
-      inputs[BLU_C + i].a = *m_ColorInputLUT[u32(cc.a.Value())][i];
-      inputs[BLU_C + i].b = *m_ColorInputLUT[u32(cc.b.Value())][i];
-      inputs[BLU_C + i].c = *m_ColorInputLUT[u32(cc.c.Value())][i];
-      inputs[BLU_C + i].d = *m_ColorInputLUT[u32(cc.d.Value())][i];
-    }
-    inputs[ALP_C].a = *m_AlphaInputLUT[u32(ac.a.Value())];
-    inputs[ALP_C].b = *m_AlphaInputLUT[u32(ac.b.Value())];
-    inputs[ALP_C].c = *m_AlphaInputLUT[u32(ac.c.Value())];
-    inputs[ALP_C].d = *m_AlphaInputLUT[u32(ac.d.Value())];
-
-    if (cc.bias != TevBias::Compare)
-      DrawColorRegular(cc, inputs);
+    std::copy_n(m_KonstLUT[kc][RED_C], NUM_LANES, StageKonst[RED_C]);
+    std::copy_n(m_KonstLUT[kc][GRN_C], NUM_LANES, StageKonst[GRN_C]);
+    std::copy_n(m_KonstLUT[kc][BLU_C], NUM_LANES, StageKonst[BLU_C]);
+    std::copy_n(m_KonstLUT[ka][ALP_C], NUM_LANES, StageKonst[ALP_C]);
+
+#ifdef _M_X86_64
+    if (m_jit)
+      m_jit->GetStage(stageNum, bpmem.combiners[stageNum])(this);
     else
-      DrawColorCompare(cc, inputs);
-
-    if (cc.clamp)
-    {
-      Reg[u32(cc.dest.Value())][RED_C] = Clamp255(Reg[u32(cc.dest.Value())][RED_C]);
-      Reg[u32(cc.dest.Value())][GRN_C] = Clamp255(Reg[u32(cc.dest.Value())][GRN_C]);
-      Reg[u32(cc.dest.Value())][BLU_C] = Clamp255(Reg[u32(cc.dest.Value())][BLU_C]);
-    }
-    else
-    {
-      Reg[u32(cc.dest.Value())][RED_C] = Clamp1024(Reg[u32(cc.dest.Value())][RED_C]);
-      Reg[u32(cc.dest.Value())][GRN_C] = Clamp1024(Reg[u32(cc.dest.Value())][GRN_C]);
-      Reg[u32(cc.dest.Value())][BLU_C] = Clamp1024(Reg[u32(cc.dest.Value())][BLU_C]);
-    }
-
-    if (ac.bias != TevBias::Compare)
-      DrawAlphaRegular(ac, inputs);
-    else
-      DrawAlphaCompare(ac, inputs);
-
-    if (ac.clamp)
-      Reg[u32(ac.dest.Value())][ALP_C] = Clamp255(Reg[u32(ac.dest.Value())][ALP_C]);
-    else
-      Reg[u32(ac.dest.Value())][ALP_C] = Clamp1024(Reg[u32(ac.dest.Value())][ALP_C]);
+#endif
+      DrawCombiners(cc, ac);
 
 #if ALLOW_TEV_DUMPS
     if (g_ActiveConfig.bDumpTevStages)
     {
-      u8 stage[4] = {(u8)Reg[0][RED_C], (u8)Reg[0][GRN_C], (u8)Reg[0][BLU_C], (u8)Reg[0][ALP_C]};
-      DebugUtil::DrawTempBuffer(stage, DIRECT + stageNum);
+      ForEachLane(coverage_mask, [&](int lane) {
+        u8 stage[4] = {(u8)Reg[0][RED_C][lane], (u8)Reg[0][GRN_C][lane], (u8)Reg[0][BLU_C][lane],
+                       (u8)Reg[0][ALP_C][lane]};
+        DebugUtil::DrawTempBuffer(stage, DIRECT + stageNum);
+      });
     }
 #endif
   }
@@ -709,11 +921,20 @@ void Tev::Draw()
   // regardless of the used destination register - TODO: Verify!
   const u32 color_index = u32(bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest.Value());
   const u32 alpha_index = u32(bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest.Value());
-  u8 output[4] = {(u8)Reg[alpha_index][ALP_C], (u8)Reg[color_index][BLU_C],
-                  (u8)Reg[color_index][GRN_C], (u8)Reg[color_index][RED_C]};
 
-  if (!TevAlphaTest(output[ALP_C]))
-    return;
+  coverage_mask &= TevAlphaTest(LoadInput8(Reg[alpha_index][ALP_C]));
+
+  ForEachLane(coverage_mask, [&](int lane) {
+    u8 output[4] = {(u8)Reg[alpha_index][ALP_C][lane], (u8)Reg[color_index][BLU_C][lane],
+                    (u8)Reg[color_index][GRN_C][lane], (u8)Reg[color_index][RED_C][lane]};
+    FinishPixel(lane, output);
+  });
+}
+
+void Tev::FinishPixel(int lane, u8* output)
+{
+  ASSERT(Position[lane][0] >= 0 && Position[lane][0] < s32(EFB_WIDTH));
+  ASSERT(Position[lane][1] >= 0 && Position[lane][1] < s32(EFB_HEIGHT));
 
   // z texture
   if (bpmem.ztex2.op != ZTexOp::Disabled)
@@ -722,22 +943,22 @@ void Tev::Draw()
     switch (bpmem.ztex2.type)
     {
     case ZTexFormat::U8:
-      ztex += TexColor[ALP_C];
+      ztex += TexColor[ALP_C][lane];
       break;
     case ZTexFormat::U16:
-      ztex += TexColor[ALP_C] << 8 | TexColor[RED_C];
+      ztex += TexColor[ALP_C][lane] << 8 | TexColor[RED_C][lane];
       break;
     case ZTexFormat::U24:
-      ztex += TexColor[RED_C] << 16 | TexColor[GRN_C] << 8 | TexColor[BLU_C];
+      ztex += TexColor[RED_C][lane] << 16 | TexColor[GRN_C][lane] << 8 | TexColor[BLU_C][lane];
       break;
     default:
       PanicAlertFmt("Invalid ztex format {}", bpmem.ztex2.type);
     }
 
     if (bpmem.ztex2.op == ZTexOp::Add)
-      ztex += Position[2];
+      ztex += Position[lane][2];
 
-    Position[2] = ztex & 0x00ffffff;
+    Position[lane][2] = ztex & 0x00ffffff;
   }
 
   // fog
@@ -749,7 +970,7 @@ void Tev::Draw()
     {
       // perspective
       // ze = A/(B - (Zs >> B_SHF))
-      const s32 denom = bpmem.fog.b_magnitude - (Position[2] >> bpmem.fog.b_shift);
+      const s32 denom = bpmem.fog.b_magnitude - (Position[lane][2] >> bpmem.fog.b_shift);
       // in addition downscale magnitude and zs to 0.24 bits
       ze = (bpmem.fog.GetA() * 16777215.0f) / static_cast<float>(denom);
     }
@@ -758,7 +979,7 @@ void Tev::Draw()
       // orthographic
       // ze = a*Zs
       // in addition downscale zs to 0.24 bits
-      ze = bpmem.fog.GetA() * (static_cast<float>(Position[2]) / 16777215.0f);
+      ze = bpmem.fog.GetA() * (static_cast<float>(Position[lane][2]) / 16777215.0f);
     }
 
     if (bpmem.fogRange.Base.Enabled)
@@ -770,7 +991,7 @@ void Tev::Draw()
 
       // First, calculate the offset from the viewport center (normalized to 0..1)
       const float offset =
-          (Position[0] - (static_cast<s32>(bpmem.fogRange.Base.Center.Value()) - 342)) /
+          (Position[lane][0] - (static_cast<s32>(bpmem.fogRange.Base.Center.Value()) - 342)) /
           static_cast<float>(xfmem.viewport.wd);
 
       // Based on that, choose the index such that points which are far away from the z-axis use the
@@ -832,22 +1053,25 @@ void Tev::Draw()
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
 
-    if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
+    if (!EfbInterface::ZCompare(Position[lane][0], Position[lane][1], Position[lane][2]))
       return;
 
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
   }
 
-  BoundingBox::Update(static_cast<u16>(Position[0]), static_cast<u16>(Position[0]),
-                      static_cast<u16>(Position[1]), static_cast<u16>(Position[1]));
+  if (BoundingBox::IsEnabled())
+  {
+    BoundingBox::Update(static_cast<u16>(Position[lane][0]), static_cast<u16>(Position[lane][0]),
+                        static_cast<u16>(Position[lane][1]), static_cast<u16>(Position[lane][1]));
+  }
 
 #if ALLOW_TEV_DUMPS
   if (g_ActiveConfig.bDumpTevStages)
   {
     for (u32 i = 0; i < bpmem.genMode.numindstages; ++i)
-      DebugUtil::CopyTempBuffer(Position[0], Position[1], INDIRECT, i, "Indirect");
+      DebugUtil::CopyTempBuffer(Position[lane][0], Position[lane][1], INDIRECT, i, "Indirect");
     for (u32 i = 0; i <= bpmem.genMode.numtevstages; ++i)
-      DebugUtil::CopyTempBuffer(Position[0], Position[1], DIRECT, i, "Stage");
+      DebugUtil::CopyTempBuffer(Position[lane][0], Position[lane][1], DIRECT, i, "Stage");
   }
 
   if (g_ActiveConfig.bDumpTevTextureFetches)
@@ -856,18 +1080,18 @@ void Tev::Draw()
     {
       TwoTevStageOrders& order = bpmem.tevorders[i >> 1];
       if (order.getEnable(i & 1))
-        DebugUtil::CopyTempBuffer(Position[0], Position[1], DIRECT_TFETCH, i, "TFetch");
+        DebugUtil::CopyTempBuffer(Position[lane][0], Position[lane][1], DIRECT_TFETCH, i, "TFetch");
     }
   }
 #endif
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
+  PixelsOut++;
   EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
-  EfbInterface::BlendTev(Position[0], Position[1], output);
+  EfbInterface::BlendTev(Position[lane][0], Position[lane][1], output);
 }
 
 void Tev::SetRegColor(int reg, int comp, s16 color)
 {
-  KonstantColors[reg][comp] = color;
+  std::fill_n(KonstantColors[reg][comp], NUM_LANES, color);
 }
@@ -4,17 +4,28 @@
 
 #pragma once
 
+#include <memory>
+
 #include "VideoCommon/BPMemory.h"
 
+class TevJit;
+
 class Tev
 {
-  struct InputRegType
-  {
-    unsigned a : 8;
-    unsigned b : 8;
-    unsigned c : 8;
-    signed d : 11;
-  };
+public:
+  Tev();
+  ~Tev();
+
+  // Pixels are shaded in 2x2 quads. Every per-pixel value has one entry per lane, where lane
+  // x + y * 2 holds the pixel at offset (x, y) in the quad.
+  static constexpr int NUM_LANES = 4;
+
+private:
+  // Compiled combiners address the registers and input LUTs relative to the Tev.
+  friend class TevJit;
+
+  // The combiner inputs of every lane, defined with the SIMD helpers in Tev.cpp.
+  struct InputRegType;
 
   struct TextureCoordinateType
   {
@@ -23,25 +34,30 @@ class Tev
   };
 
   // color order: ABGR
-  s16 Reg[4][4];
-  s16 KonstantColors[4][4];
-  s16 TexColor[4];
-  s16 RasColor[4];
-  s16 StageKonst[4];
-  s16 Zero16[4];
-
-  s16 FixedConstants[9];
-  u8 AlphaBump;
-  u8 IndirectTex[4][4];
-  TextureCoordinateType TexCoord;
-
-  s16* m_ColorInputLUT[16][3];
-  s16* m_AlphaInputLUT[8];  // values must point to ABGR color
-  s16* m_KonstLUT[32][4];
+  alignas(16) s32 Reg[4][4][NUM_LANES];
+  alignas(16) s32 KonstantColors[4][4][NUM_LANES];
+  alignas(16) s32 TexColor[4][NUM_LANES];
+  alignas(16) s32 RasColor[4][NUM_LANES];
+  alignas(16) s32 StageKonst[4][NUM_LANES];
+  alignas(16) s32 Zero16[4][NUM_LANES];
+
+  alignas(16) s32 FixedConstants[9][NUM_LANES];
+  u8 AlphaBump[NUM_LANES];
+  u8 IndirectTex[NUM_LANES][4][4];
+  TextureCoordinateType TexCoord[NUM_LANES];
+
+  const s32* m_ColorInputLUT[16][3];
+  const s32* m_AlphaInputLUT[8];  // values must point to ABGR color
+  const s32* m_KonstLUT[32][4];
   s16 m_BiasLUT[4];
   u8 m_ScaleLShiftLUT[4];
   u8 m_ScaleRShiftLUT[4];
 
+#ifdef _M_X86_64
+  // Null when the JIT is disabled, in which case the combiners are interpreted.
+  std::unique_ptr<TevJit> m_jit;
+#endif
+
   // enumeration for color input LUT
   enum
   {
@@ -57,24 +73,35 @@ class Tev
     INDIRECT = 32
   };
 
-  void SetRasColor(RasColorChan colorChan, int swaptable);
+  void SetRasColor(int lane, RasColorChan colorChan, int swaptable);
 
   void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+  // Interprets both combiners of a stage.
+  void DrawCombiners(const TevStageCombiner::ColorCombiner& cc,
+                     const TevStageCombiner::AlphaCombiner& ac);
 
-  void Indirect(unsigned int stageNum, s32 s, s32 t);
+  void Indirect(int lane, unsigned int stageNum, s32 s, s32 t);
+
+  // Runs everything after the alpha test for a single lane.
+  void FinishPixel(int lane, u8* output);
 
 public:
-  s32 Position[3];
-  u8 Color[2][4];  // must be RGBA for correct swap table ordering
-  TextureCoordinateType Uv[8];
+  s32 Position[NUM_LANES][3];
+  u8 Color[NUM_LANES][2][4];  // must be RGBA for correct swap table ordering
+  TextureCoordinateType Uv[NUM_LANES][8];
+  // Level of detail is calculated once per quad.
   s32 IndirectLod[4];
   bool IndirectLinear[4];
   s32 TextureLod[16];
   bool TextureLinear[16];
 
+  // Kept per Tev rather than in g_stats, since every rasterizer thread has its own Tev.
+  u32 PixelsIn = 0;
+  u32 PixelsOut = 0;
+
   enum
   {
     ALP_C,
@@ -85,7 +112,9 @@ public:
 
   void Init();
 
-  void Draw();
+  // Shades the lanes set in coverage_mask. The TEV stages and the alpha test run on all lanes at
+  // once; everything that touches the EFB runs for each remaining lane in turn.
+  void Draw(u32 coverage_mask);
 
   void SetRegColor(int reg, int comp, s16 color);
 };
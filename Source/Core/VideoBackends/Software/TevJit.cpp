@@ -0,0 +1,329 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/Software/TevJit.h"
+
+#include "Common/CommonTypes.h"
+#include "Common/JitRegister.h"
+#include "Common/x64ABI.h"
+#include "Common/x64Emitter.h"
+#include "VideoBackends/Software/Tev.h"
+
+using namespace Gen;
+
+// Only XMM0-XMM5 and RAX are used, which are caller-saved on every x64 ABI.
+static const X64Reg tev_reg = ABI_PARAM1;
+
+constexpr size_t CODE_SIZE = 256 * 1024;
+// Far more than the largest stage needs. The cache starts over once less than this is left.
+constexpr size_t MAX_STAGE_SIZE = 4096;
+
+enum ConstantOffset
+{
+  CONST_MASK_FF = 0,
+  CONST_256 = 16,
+  // Clamp bounds, as 16-bit lanes.
+  CONST_ZERO = 32,
+  CONST_255 = 48,
+  CONST_MINUS_1024 = 64,
+  CONST_1023 = 80,
+};
+
+TevJit::TevJit(const Tev& tev) : m_tev(tev)
+{
+  AllocCodeSpace(CODE_SIZE);
+  Clear();
+}
+
+TevJit::StageFunction TevJit::GetStage(u32 stage, const TevStageCombiner& combiner)
+{
+  // rswap and tswap only select the texture and rasterized colors, which are sampled outside.
+  const u64 key =
+      (u64(combiner.colorC.hex & 0xffffff) << 20) | ((combiner.alphaC.hex >> 4) & 0xfffff);
+
+  CachedStage& recent = m_recent_stages[stage];
+  if (recent.key == key)
+    return recent.function;
+
+  auto it = m_stages.find(key);
+  if (it == m_stages.end())
+  {
+    if (GetSpaceLeft() < MAX_STAGE_SIZE)
+      Clear();
+    it = m_stages.emplace(key, Compile(combiner.colorC, combiner.alphaC)).first;
+  }
+
+  recent.key = key;
+  recent.function = it->second;
+  return it->second;
+}
+
+void TevJit::Clear()
+{
+  ClearCodeSpace();
+  m_stages.clear();
+  m_recent_stages.fill({});
+
+  AlignCode16();
+  m_constants = GetCodePtr();
+  for (int i = 0; i < 4; i++)
+    Write32(0xff);
+  for (int i = 0; i < 4; i++)
+    Write32(256);
+  for (const s16 value : {s16(0), s16(255), s16(-1024), s16(1023)})
+  {
+    for (int i = 0; i < 8; i++)
+      Write16(u16(value));
+  }
+}
+
+TevJit::StageFunction TevJit::Compile(const TevStageCombiner::ColorCombiner& cc,
+                                      const TevStageCombiner::AlphaCombiner& ac)
+{
+  AlignCode16();
+  const u8* start = GetCodePtr();
+
+  // The interpreter gathers every input before writing any result. Alpha is computed first and
+  // stored last, and each color channel only reads its own channel or alpha, so the same holds
+  // here without spilling the inputs.
+  EmitAlpha(cc, ac);
+  EmitColor(cc);
+  MOVDQA(MDisp(tev_reg, GetOffset(m_tev.Reg[u32(ac.dest.Value())][Tev::ALP_C])), XMM5);
+  RET();
+
+  JitRegister::Register(start, GetCodePtr(), "TevJit_%06x_%06x", cc.hex & 0xffffff,
+                        ac.hex & 0xffffff);
+  return reinterpret_cast<StageFunction>(const_cast<u8*>(start));
+}
+
+// Leaves the clamped result in XMM5. As in the interpreter, the R8, GR16 and BGR24 compare modes
+// take their operands from the color combiner's inputs.
+void TevJit::EmitAlpha(const TevStageCombiner::ColorCombiner& cc,
+                       const TevStageCombiner::AlphaCombiner& ac)
+{
+  const s32 a = GetOffset(m_tev.m_AlphaInputLUT[u32(ac.a.Value())]);
+  const s32 b = GetOffset(m_tev.m_AlphaInputLUT[u32(ac.b.Value())]);
+  const s32 c = GetOffset(m_tev.m_AlphaInputLUT[u32(ac.c.Value())]);
+  const s32 d = GetOffset(m_tev.m_AlphaInputLUT[u32(ac.d.Value())]);
+
+  if (ac.bias != TevBias::Compare)
+  {
+    const u8 lshift = m_tev.m_ScaleLShiftLUT[u32(ac.scale.Value())];
+    const u8 rshift = m_tev.m_ScaleRShiftLUT[u32(ac.scale.Value())];
+    const s32 round = (ac.scale != TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
+
+    EmitLerp(XMM0, a, b, c, lshift);
+    if (round != 0)
+    {
+      EmitBroadcast(XMM1, round);
+      PADDD(XMM0, R(XMM1));
+    }
+    if (ac.op == TevOp::Sub)
+    {
+      PXOR(XMM1, R(XMM1));
+      PSUBD(XMM1, R(XMM0));
+      MOVDQA(XMM0, R(XMM1));
+    }
+    PSRAD(XMM0, 8);
+
+    EmitLoad11(XMM5, d);
+    const s32 bias = m_tev.m_BiasLUT[u32(ac.bias.Value())];
+    if (bias != 0)
+    {
+      EmitBroadcast(XMM1, bias);
+      PADDD(XMM5, R(XMM1));
+    }
+    if (lshift != 0)
+      PSLLD(XMM5, lshift);
+    PADDD(XMM5, R(XMM0));
+    if (rshift != 0)
+      PSRAD(XMM5, rshift);
+  }
+  else
+  {
+    if (ac.compare_mode == TevCompareMode::A8)
+    {
+      EmitLoad8(XMM0, a);
+      EmitLoad8(XMM1, b);
+    }
+    else
+    {
+      EmitComposite(XMM0, ac.compare_mode, m_tev.m_ColorInputLUT[u32(cc.a.Value())]);
+      EmitComposite(XMM1, ac.compare_mode, m_tev.m_ColorInputLUT[u32(cc.b.Value())]);
+    }
+
+    if (ac.comparison == TevComparison::GT)
+      PCMPGTD(XMM0, R(XMM1));
+    else
+      PCMPEQD(XMM0, R(XMM1));
+
+    EmitLoad8(XMM1, c);
+    PAND(XMM0, R(XMM1));
+    EmitLoad11(XMM5, d);
+    PADDD(XMM5, R(XMM0));
+  }
+
+  EmitClamp(XMM5, ac.clamp);
+}
+
+// Stores every channel as soon as it is computed, without touching XMM5.
+void TevJit::EmitColor(const TevStageCombiner::ColorCombiner& cc)
+{
+  const auto& inputs = m_tev.m_ColorInputLUT;
+  const u32 dest = u32(cc.dest.Value());
+
+  if (cc.bias != TevBias::Compare)
+  {
+    const u8 lshift = m_tev.m_ScaleLShiftLUT[u32(cc.scale.Value())];
+    const u8 rshift = m_tev.m_ScaleRShiftLUT[u32(cc.scale.Value())];
+    const s32 round = (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
+    const s32 bias = m_tev.m_BiasLUT[u32(cc.bias.Value())];
+
+    for (int i = 0; i < 3; i++)
+    {
+      EmitLerp(XMM0, GetOffset(inputs[u32(cc.a.Value())][i]),
+               GetOffset(inputs[u32(cc.b.Value())][i]), GetOffset(inputs[u32(cc.c.Value())][i]),
+               lshift);
+      if (round != 0)
+      {
+        EmitBroadcast(XMM1, round);
+        PADDD(XMM0, R(XMM1));
+      }
+      PSRAD(XMM0, 8);
+      if (cc.op == TevOp::Sub)
+      {
+        PXOR(XMM1, R(XMM1));
+        PSUBD(XMM1, R(XMM0));
+        MOVDQA(XMM0, R(XMM1));
+      }
+
+      EmitLoad11(XMM4, GetOffset(inputs[u32(cc.d.Value())][i]));
+      if (bias != 0)
+      {
+        EmitBroadcast(XMM1, bias);
+        PADDD(XMM4, R(XMM1));
+      }
+      if (lshift != 0)
+        PSLLD(XMM4, lshift);
+      PADDD(XMM4, R(XMM0));
+      if (rshift != 0)
+        PSRAD(XMM4, rshift);
+
+      EmitClamp(XMM4, cc.clamp);
+      MOVDQA(MDisp(tev_reg, GetOffset(m_tev.Reg[dest][Tev::BLU_C + i])), XMM4);
+    }
+    return;
+  }
+
+  // Apart from RGB8, every channel uses the same comparison.
+  if (cc.compare_mode != TevCompareMode::RGB8)
+  {
+    EmitComposite(XMM0, cc.compare_mode, inputs[u32(cc.a.Value())]);
+    EmitComposite(XMM1, cc.compare_mode, inputs[u32(cc.b.Value())]);
+    if (cc.comparison == TevComparison::GT)
+      PCMPGTD(XMM0, R(XMM1));
+    else
+      PCMPEQD(XMM0, R(XMM1));
+    MOVDQA(XMM3, R(XMM0));
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    if (cc.compare_mode == TevCompareMode::RGB8)
+    {
+      EmitLoad8(XMM3, GetOffset(inputs[u32(cc.a.Value())][i]));
+      EmitLoad8(XMM1, GetOffset(inputs[u32(cc.b.Value())][i]));
+      if (cc.comparison == TevComparison::GT)
+        PCMPGTD(XMM3, R(XMM1));
+      else
+        PCMPEQD(XMM3, R(XMM1));
+    }
+
+    EmitLoad8(XMM0, GetOffset(inputs[u32(cc.c.Value())][i]));
+    PAND(XMM0, R(XMM3));
+    EmitLoad11(XMM4, GetOffset(inputs[u32(cc.d.Value())][i]));
+    PADDD(XMM4, R(XMM0));
+
+    EmitClamp(XMM4, cc.clamp);
+    MOVDQA(MDisp(tev_reg, GetOffset(m_tev.Reg[dest][Tev::BLU_C + i])), XMM4);
+  }
+}
+
+// dest = (a * (256 - c) + b * c) << lshift, where c is scaled from [0, 255] to [0, 256].
+// Clobbers XMM1-XMM3.
+void TevJit::EmitLerp(X64Reg dest, s32 a, s32 b, s32 c, u8 lshift)
+{
+  EmitLoad8(XMM2, c);
+  MOVDQA(XMM3, R(XMM2));
+  PSRAD(XMM3, 7);
+  PADDD(XMM2, R(XMM3));
+  MOVDQA(XMM3, M(m_constants + CONST_256));
+  PSUBD(XMM3, R(XMM2));
+
+  // The upper halves of every lane are zero, so PMADDWD just multiplies the lower halves.
+  EmitLoad8(dest, a);
+  PMADDWD(dest, R(XMM3));
+  EmitLoad8(XMM1, b);
+  PMADDWD(XMM1, R(XMM2));
+  PADDD(dest, R(XMM1));
+  if (lshift != 0)
+    PSLLD(dest, lshift);
+}
+
+// Packs the selected 8-bit channels into one value for the R8, GR16 and BGR24 compare modes.
+// inputs holds the blue, green and red channel. Clobbers XMM2.
+void TevJit::EmitComposite(X64Reg dest, TevCompareMode mode, const s32* const* inputs)
+{
+  EmitLoad8(dest, GetOffset(inputs[2]));
+  if (mode == TevCompareMode::R8)
+    return;
+
+  EmitLoad8(XMM2, GetOffset(inputs[1]));
+  PSLLD(XMM2, 8);
+  POR(dest, R(XMM2));
+  if (mode == TevCompareMode::GR16)
+    return;
+
+  EmitLoad8(XMM2, GetOffset(inputs[0]));
+  PSLLD(XMM2, 16);
+  POR(dest, R(XMM2));
+}
+
+void TevJit::EmitLoad8(X64Reg dest, s32 offset)
+{
+  MOVDQA(dest, MDisp(tev_reg, offset));
+  PAND(dest, M(m_constants + CONST_MASK_FF));
+}
+
+// Sign-extends the lowest 11 bits.
+void TevJit::EmitLoad11(X64Reg dest, s32 offset)
+{
+  MOVDQA(dest, MDisp(tev_reg, offset));
+  PSLLD(dest, 21);
+  PSRAD(dest, 21);
+}
+
+void TevJit::EmitBroadcast(X64Reg dest, s32 value)
+{
+  MOV(32, R(EAX), Imm32(u32(value)));
+  MOVD_xmm(dest, R(EAX));
+  PSHUFD(dest, R(dest), 0);
+}
+
+// SSE2 has no 32-bit min and max, but every combiner result fits in 16 bits, and saturating to
+// them doesn't change the clamped value anyway.
+void TevJit::EmitClamp(X64Reg reg, bool clamp)
+{
+  PACKSSDW(reg, R(reg));
+  PMAXSW(reg, M(m_constants + (clamp ? CONST_ZERO : CONST_MINUS_1024)));
+  PMINSW(reg, M(m_constants + (clamp ? CONST_255 : CONST_1023)));
+  PUNPCKLWD(reg, R(reg));
+  PSRAD(reg, 16);
+}
+
+s32 TevJit::GetOffset(const s32* value) const
+{
+  return static_cast<s32>(reinterpret_cast<const u8*>(value) -
+                          reinterpret_cast<const u8*>(&m_tev));
+}
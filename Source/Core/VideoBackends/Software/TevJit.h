@@ -0,0 +1,58 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+
+#include "Common/CommonTypes.h"
+#include "Common/x64Emitter.h"
+#include "VideoCommon/BPMemory.h"
+
+class Tev;
+
+// Compiles the combiners of a TEV stage into SSE2 code for the exact configuration in use, so the
+// Software renderer doesn't have to decode it again for every quad. Compiled stages are cached by
+// their combiner registers, much like ShaderCache does for the hardware backends.
+class TevJit : public Gen::X64CodeBlock
+{
+public:
+  // Combines the inputs of all lanes and writes the clamped results to the destination registers.
+  using StageFunction = void (*)(Tev* tev);
+
+  // The generated code addresses registers relative to tev, so it can only be used with it.
+  explicit TevJit(const Tev& tev);
+
+  StageFunction GetStage(u32 stage, const TevStageCombiner& combiner);
+
+private:
+  struct CachedStage
+  {
+    u64 key = UINT64_MAX;
+    StageFunction function = nullptr;
+  };
+
+  StageFunction Compile(const TevStageCombiner::ColorCombiner& cc,
+                        const TevStageCombiner::AlphaCombiner& ac);
+  void Clear();
+
+  void EmitAlpha(const TevStageCombiner::ColorCombiner& cc,
+                 const TevStageCombiner::AlphaCombiner& ac);
+  void EmitColor(const TevStageCombiner::ColorCombiner& cc);
+  void EmitLerp(Gen::X64Reg dest, s32 a, s32 b, s32 c, u8 lshift);
+  void EmitComposite(Gen::X64Reg dest, TevCompareMode mode, const s32* const* inputs);
+  void EmitLoad8(Gen::X64Reg dest, s32 offset);
+  void EmitLoad11(Gen::X64Reg dest, s32 offset);
+  void EmitBroadcast(Gen::X64Reg dest, s32 value);
+  void EmitClamp(Gen::X64Reg reg, bool clamp);
+
+  s32 GetOffset(const s32* value) const;
+
+  const Tev& m_tev;
+  const u8* m_constants = nullptr;
+  std::unordered_map<u64, StageFunction> m_stages;
+  // The previous lookup for every stage, which is nearly always the one needed next.
+  std::array<CachedStage, 16> m_recent_stages;
+};
@@ -5,9 +5,16 @@
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
 
+#include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Core/HW/Memmap.h"
 
@@ -107,52 +114,93 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
   }
 }
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+namespace
+{
+// Where a mip level of a texture is read from, exactly as sampling it would.
+struct TextureSource
+{
+  const u8* data;
+  // The green and blue half of RGBA8 textures in manually managed TMEM.
+  const u8* data_odd;
+  const u8* tlut;
+  // Largest valid texel coordinates.
+  int max_s;
+  int max_t;
+  // Size of the level, rounded up to whole blocks.
+  u32 size;
+  TextureFormat format;
+  TLUTFormat tlut_format;
+  bool rgba8_from_tmem;
+};
+
+// A texture decoded to RGBA8 in the sampler's component order, one vector per mip level.
+struct DecodedLevel
+{
+  int max_s;
+  int max_t;
+  std::vector<u32> texels;
+};
+
+struct DecodedTexture
+{
+  std::vector<DecodedLevel> levels;
+  size_t size = 0;
+};
+}  // namespace
+
+// Decoded textures are kept until they take up this much memory, then decoded again as needed.
+constexpr size_t DECODED_TEXTURE_BUDGET = 256 * 1024 * 1024;
+
+static std::unordered_map<u64, DecodedTexture> s_decoded_textures;
+static size_t s_decoded_textures_size;
+// Only changed between batches, while no rasterizer thread is sampling.
+static std::array<const DecodedTexture*, 8> s_bound_textures;
+
+static TextureSource GetSource(u8 texmap, s32 mip)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
 
-  const TexMode0& tm0 = texUnit.texMode0[subTexmap];
   const TexImage0& ti0 = texUnit.texImage0[subTexmap];
   const TexTLUT& texTlut = texUnit.texTlut[subTexmap];
-  const TextureFormat texfmt = ti0.format;
-  const TLUTFormat tlutfmt = texTlut.tlut_format;
 
-  const u8* imageSrc;
-  const u8* imageSrcOdd = nullptr;
+  TextureSource source;
+  source.format = ti0.format;
+  source.tlut_format = texTlut.tlut_format;
+  source.rgba8_from_tmem = source.format == TextureFormat::RGBA8 &&
+                           texUnit.texImage1[subTexmap].cache_manually_managed;
+  source.data_odd = nullptr;
+
   if (texUnit.texImage1[subTexmap].cache_manually_managed)
   {
-    imageSrc = &texMem[texUnit.texImage1[subTexmap].tmem_even * TMEM_LINE_SIZE];
-    if (texfmt == TextureFormat::RGBA8)
-      imageSrcOdd = &texMem[texUnit.texImage2[subTexmap].tmem_odd * TMEM_LINE_SIZE];
+    source.data = &texMem[texUnit.texImage1[subTexmap].tmem_even * TMEM_LINE_SIZE];
+    if (source.rgba8_from_tmem)
+      source.data_odd = &texMem[texUnit.texImage2[subTexmap].tmem_odd * TMEM_LINE_SIZE];
   }
   else
   {
     const u32 imageBase = texUnit.texImage3[subTexmap].image_base << 5;
-    imageSrc = Memory::GetPointer(imageBase);
+    source.data = Memory::GetPointer(imageBase);
   }
 
-  int imageWidth = ti0.width;
-  int imageHeight = ti0.height;
+  source.max_s = ti0.width;
+  source.max_t = ti0.height;
 
   const int tlutAddress = texTlut.tmem_offset << 9;
-  const u8* tlut = &texMem[tlutAddress];
+  source.tlut = &texMem[tlutAddress];
 
-  // reduce sample location and texture size to mip level
+  // reduce texture size to mip level
   // move texture pointer to mip location
+  int mipWidth = source.max_s + 1;
+  int mipHeight = source.max_t + 1;
   if (mip)
   {
-    int mipWidth = imageWidth + 1;
-    int mipHeight = imageHeight + 1;
-
-    const int fmtWidth = TexDecoder_GetBlockWidthInTexels(texfmt);
-    const int fmtHeight = TexDecoder_GetBlockHeightInTexels(texfmt);
-    const int fmtDepth = TexDecoder_GetTexelSizeInNibbles(texfmt);
+    const int fmtWidth = TexDecoder_GetBlockWidthInTexels(source.format);
+    const int fmtHeight = TexDecoder_GetBlockHeightInTexels(source.format);
+    const int fmtDepth = TexDecoder_GetTexelSizeInNibbles(source.format);
 
-    imageWidth >>= mip;
-    imageHeight >>= mip;
-    s >>= mip;
-    t >>= mip;
+    source.max_s >>= mip;
+    source.max_t >>= mip;
 
     while (mip)
     {
@@ -160,13 +208,145 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
       mipHeight = std::max(mipHeight, fmtHeight);
       const u32 size = (mipWidth * mipHeight * fmtDepth) >> 1;
 
-      imageSrc += size;
+      source.data += size;
       mipWidth >>= 1;
       mipHeight >>= 1;
       mip--;
     }
   }
+  source.size = static_cast<u32>(TexDecoder_GetTextureSizeInBytes(
+      std::max(mipWidth, 1), std::max(mipHeight, 1), source.format));
+
+  return source;
+}
 
+static void DecodeTexel(const TextureSource& source, int s, int t, u8* texel)
+{
+  if (!source.rgba8_from_tmem)
+  {
+    TexDecoder_DecodeTexel(texel, source.data, s, t, source.max_s, source.format, source.tlut,
+                           source.tlut_format);
+  }
+  else
+  {
+    TexDecoder_DecodeTexelRGBA8FromTmem(texel, source.data, source.data_odd, s, t, source.max_s);
+  }
+}
+
+// Clamps the length of data starting at ptr to what is actually backed by TMEM or emulated RAM.
+// Returns 0 if it isn't backed at all.
+static u32 GetValidLength(const u8* ptr, u32 length, u32 address)
+{
+  if (ptr >= texMem && ptr < texMem + TMEM_SIZE)
+    return std::min<u32>(length, static_cast<u32>(texMem + TMEM_SIZE - ptr));
+
+  // The whole range has to be in the same contiguous region of emulated RAM. Unlike GetPointer,
+  // this doesn't raise a panic alert for ranges which extend past the end of RAM.
+  if (!ptr || Memory::TryGetPointerForRange(address, length) != ptr)
+    return 0;
+  return length;
+}
+
+static const DecodedTexture* GetDecodedTexture(u8 texmap)
+{
+  const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
+  const u8 subTexmap = texmap & 3;
+  const TexMode0& tm0 = texUnit.texMode0[subTexmap];
+  const TexMode1& tm1 = texUnit.texMode1[subTexmap];
+
+  // Sampling rounds up to the next level, or blends with it, past the largest LOD. A max LOD past
+  // the smallest level the dimensions allow mustn't make the texture extend further into memory.
+  const TexImage0& ti0 = texUnit.texImage0[subTexmap];
+  const s32 max_levels = IntLog2(std::max<u32>(ti0.width, ti0.height) + 1) + 1;
+  const s32 num_levels = SamplerCommon::AreBpTexMode0MipmapsEnabled(tm0) ?
+                             std::min<s32>((tm1.max_lod >> 4) + 2, max_levels) :
+                             1;
+
+  const TextureSource base = GetSource(texmap, 0);
+  const TextureSource last = GetSource(texmap, num_levels - 1);
+  const u32 address = texUnit.texImage3[subTexmap].image_base << 5;
+  const u32 length = static_cast<u32>(last.data - base.data) + last.size;
+  if (!base.data || GetValidLength(base.data, length, address) != length)
+    return nullptr;
+
+  // Everything the decoded texels depend on, hashed the same way the texture cache of the
+  // hardware backends hashes textures.
+  std::array<u64, 5> key_data{};
+  key_data[0] = Common::GetHash64(base.data, length, 0);
+  if (base.rgba8_from_tmem)
+  {
+    key_data[1] = Common::GetHash64(base.data_odd, GetValidLength(base.data_odd, length, 0), 0);
+  }
+  const int palette_size = TexDecoder_GetPaletteSize(base.format);
+  if (palette_size > 0)
+  {
+    key_data[2] = Common::GetHash64(
+        base.tlut, GetValidLength(base.tlut, static_cast<u32>(palette_size), 0), 0);
+  }
+  key_data[3] = (u64(base.max_s) << 32) | u64(base.max_t);
+  key_data[4] = (u64(num_levels) << 32) | (u64(base.rgba8_from_tmem) << 16) |
+                (u64(base.tlut_format) << 8) | u64(base.format);
+  const u64 key = Common::GetHash64(reinterpret_cast<const u8*>(key_data.data()),
+                                    static_cast<u32>(sizeof(key_data)), 0);
+
+  auto it = s_decoded_textures.find(key);
+  if (it != s_decoded_textures.end())
+    return &it->second;
+
+  DecodedTexture decoded;
+  decoded.levels.resize(num_levels);
+  for (s32 mip = 0; mip < num_levels; mip++)
+  {
+    const TextureSource source = GetSource(texmap, mip);
+    DecodedLevel& level = decoded.levels[mip];
+    level.max_s = source.max_s;
+    level.max_t = source.max_t;
+    level.texels.resize(size_t(source.max_s + 1) * (source.max_t + 1));
+
+    u32* texel = level.texels.data();
+    for (int t = 0; t <= source.max_t; t++)
+    {
+      for (int s = 0; s <= source.max_s; s++)
+        DecodeTexel(source, s, t, reinterpret_cast<u8*>(texel++));
+    }
+    decoded.size += level.texels.size() * sizeof(u32);
+  }
+
+  s_decoded_textures_size += decoded.size;
+  return &s_decoded_textures.emplace(key, std::move(decoded)).first->second;
+}
+
+void PrepareTextures()
+{
+  if (s_decoded_textures_size > DECODED_TEXTURE_BUDGET)
+    ClearCache();
+
+  BitSet8 used_texmaps;
+  for (u32 stage = 0; stage < bpmem.genMode.numindstages; stage++)
+    used_texmaps[bpmem.tevindref.getTexMap(stage)] = true;
+  for (u32 stage = 0; stage <= bpmem.genMode.numtevstages; stage++)
+  {
+    const TwoTevStageOrders& order = bpmem.tevorders[stage >> 1];
+    if (order.getEnable(stage & 1))
+      used_texmaps[order.getTexMap(stage & 1)] = true;
+  }
+
+  for (u8 texmap = 0; texmap < s_bound_textures.size(); texmap++)
+    s_bound_textures[texmap] = used_texmaps[texmap] ? GetDecodedTexture(texmap) : nullptr;
+}
+
+void ClearCache()
+{
+  s_decoded_textures.clear();
+  s_decoded_textures_size = 0;
+  s_bound_textures.fill(nullptr);
+}
+
+// Samples a single mip level, where fetch(s, t, texel) reads the texel at the wrapped coordinates.
+template <typename Fetch>
+static void SampleLevel(s32 s, s32 t, int max_s, int max_t, bool linear, const TexMode0& tm0,
+                        Fetch fetch, u8* sample)
+{
   if (linear)
   {
     // offset linear sampling
@@ -187,47 +367,22 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     u8 sampledTex[4];
     u32 texel[4];
 
-    WrapCoord(&imageS, tm0.wrap_s, imageWidth);
-    WrapCoord(&imageT, tm0.wrap_t, imageHeight);
-    WrapCoord(&imageSPlus1, tm0.wrap_s, imageWidth);
-    WrapCoord(&imageTPlus1, tm0.wrap_t, imageHeight);
-
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].cache_manually_managed))
-    {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
+    WrapCoord(&imageS, tm0.wrap_s, max_s);
+    WrapCoord(&imageT, tm0.wrap_t, max_t);
+    WrapCoord(&imageSPlus1, tm0.wrap_s, max_s);
+    WrapCoord(&imageTPlus1, tm0.wrap_t, max_t);
 
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
+    fetch(imageS, imageT, sampledTex);
+    SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
 
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
+    fetch(imageSPlus1, imageT, sampledTex);
+    AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
 
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
-                             tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
-                                          imageWidth);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
+    fetch(imageS, imageTPlus1, sampledTex);
+    AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
 
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
-                                          imageTPlus1, imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
+    fetch(imageSPlus1, imageTPlus1, sampledTex);
+    AddTexel(sampledTex, texel, (fractS) * (fractT));
 
     sample[0] = (u8)(texel[0] >> 14);
     sample[1] = (u8)(texel[1] >> 14);
@@ -241,14 +396,41 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageT = t >> 7;
 
     // nearest neighbor sampling
-    WrapCoord(&imageS, tm0.wrap_s, imageWidth);
-    WrapCoord(&imageT, tm0.wrap_t, imageHeight);
+    WrapCoord(&imageS, tm0.wrap_s, max_s);
+    WrapCoord(&imageT, tm0.wrap_t, max_t);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].cache_manually_managed))
-      TexDecoder_DecodeTexel(sample, imageSrc, imageS, imageT, imageWidth, texfmt, tlut, tlutfmt);
-    else
-      TexDecoder_DecodeTexelRGBA8FromTmem(sample, imageSrc, imageSrcOdd, imageS, imageT,
-                                          imageWidth);
+    fetch(imageS, imageT, sample);
   }
 }
+
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+{
+  const TexMode0& tm0 = bpmem.tex[(texmap >> 2) & 1].texMode0[texmap & 3];
+
+  // reduce sample location to mip level
+  s >>= mip;
+  t >>= mip;
+
+  const DecodedTexture* decoded = s_bound_textures[texmap];
+  if (decoded && mip < static_cast<s32>(decoded->levels.size()))
+  {
+    const DecodedLevel& level = decoded->levels[mip];
+    const u32* texels = level.texels.data();
+    const size_t pitch = size_t(level.max_s) + 1;
+    SampleLevel(s, t, level.max_s, level.max_t, linear, tm0,
+                [texels, pitch](int texel_s, int texel_t, u8* texel) {
+                  std::memcpy(texel, &texels[texel_t * pitch + texel_s], sizeof(u32));
+                },
+                sample);
+    return;
+  }
+
+  // The texture couldn't be decoded up front, e.g. because it extends past the end of RAM.
+  const TextureSource source = GetSource(texmap, mip);
+  SampleLevel(s, t, source.max_s, source.max_t, linear, tm0,
+              [&source](int texel_s, int texel_t, u8* texel) {
+                DecodeTexel(source, texel_s, texel_t, texel);
+              },
+              sample);
+}
 }  // namespace TextureSampler
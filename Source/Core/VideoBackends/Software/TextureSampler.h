@@ -8,6 +8,11 @@
 
 namespace TextureSampler
 {
+// Decodes the textures sampled by the current TEV configuration, or finds them among the already
+// decoded ones. Must be called before drawing with new texture state, while nothing is sampling.
+void PrepareTextures();
+void ClearCache();
+
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
 
 void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
@@ -11,6 +11,7 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
@@ -109,6 +110,142 @@ void TransformNormal(const InputVertexData* src, bool nbt, OutputVertexData* dst
   }
 }
 
+#ifdef _M_X86
+// Transforms the vectors of four vertices, given as one register per component, by their 3x3 or
+// 3x4 matrices. The operations are done in the same order as in MultiplyVec3Mat33/34, so the
+// results are identical.
+template <int COLUMNS>
+static void MultiplyVec3Mat3x4Lanes(const __m128 vec[3], const float* const mats[4],
+                                    __m128 result[3])
+{
+  const bool shared = mats[0] == mats[1] && mats[0] == mats[2] && mats[0] == mats[3];
+  const auto element = [&](int i) {
+    if (shared)
+      return _mm_set1_ps(mats[0][i]);
+    return _mm_setr_ps(mats[0][i], mats[1][i], mats[2][i], mats[3][i]);
+  };
+
+  for (int row = 0; row < 3; row++)
+  {
+    __m128 sum = _mm_mul_ps(element(row * COLUMNS), vec[0]);
+    sum = _mm_add_ps(sum, _mm_mul_ps(element(row * COLUMNS + 1), vec[1]));
+    sum = _mm_add_ps(sum, _mm_mul_ps(element(row * COLUMNS + 2), vec[2]));
+    if (COLUMNS == 4)
+      sum = _mm_add_ps(sum, element(row * COLUMNS + 3));
+    result[row] = sum;
+  }
+}
+
+static void LoadVec3Lanes(const Vec3& v0, const Vec3& v1, const Vec3& v2, const Vec3& v3,
+                          __m128 result[3])
+{
+  result[0] = _mm_setr_ps(v0.x, v1.x, v2.x, v3.x);
+  result[1] = _mm_setr_ps(v0.y, v1.y, v2.y, v3.y);
+  result[2] = _mm_setr_ps(v0.z, v1.z, v2.z, v3.z);
+}
+
+static void StoreVec3Lanes(const __m128 vec[3], Vec3* const results[4])
+{
+  alignas(16) float components[3][4];
+  for (int i = 0; i < 3; i++)
+    _mm_store_ps(components[i], vec[i]);
+  for (int lane = 0; lane < 4; lane++)
+    *results[lane] = Vec3(components[0][lane], components[1][lane], components[2][lane]);
+}
+#endif
+
+void TransformPositions(const InputVertexData* src, OutputVertexData* dst, std::size_t count)
+{
+  std::size_t i = 0;
+#ifdef _M_X86
+  const Projection::Raw& proj = xfmem.projection.rawProjection;
+  const bool perspective = xfmem.projection.type == ProjectionType::Perspective;
+  for (; i + 4 <= count; i += 4)
+  {
+    const InputVertexData* in = &src[i];
+    OutputVertexData* out = &dst[i];
+    const float* const mats[4] = {
+        &xfmem.posMatrices[in[0].posMtx * 4], &xfmem.posMatrices[in[1].posMtx * 4],
+        &xfmem.posMatrices[in[2].posMtx * 4], &xfmem.posMatrices[in[3].posMtx * 4]};
+
+    __m128 pos[3];
+    __m128 mv[3];
+    LoadVec3Lanes(in[0].position, in[1].position, in[2].position, in[3].position, pos);
+    MultiplyVec3Mat3x4Lanes<4>(pos, mats, mv);
+    Vec3* const mv_results[4] = {&out[0].mvPosition, &out[1].mvPosition, &out[2].mvPosition,
+                                 &out[3].mvPosition};
+    StoreVec3Lanes(mv, mv_results);
+
+    // Same as MultipleVec3Perspective and MultipleVec3Ortho.
+    __m128 projected[4];
+    if (perspective)
+    {
+      projected[0] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[0]), mv[0]),
+                                _mm_mul_ps(_mm_set1_ps(proj[1]), mv[2]));
+      projected[1] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[2]), mv[1]),
+                                _mm_mul_ps(_mm_set1_ps(proj[3]), mv[2]));
+      projected[2] = _mm_mul_ps(
+          _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[4]), mv[2]), _mm_set1_ps(proj[5])),
+          _mm_set1_ps(1.0f - (float)1e-7));
+      projected[3] = _mm_xor_ps(mv[2], _mm_set1_ps(-0.0f));
+    }
+    else
+    {
+      projected[0] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[0]), mv[0]), _mm_set1_ps(proj[1]));
+      projected[1] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[2]), mv[1]), _mm_set1_ps(proj[3]));
+      projected[2] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[4]), mv[2]), _mm_set1_ps(proj[5]));
+      projected[3] = _mm_set1_ps(1.0f);
+    }
+
+    alignas(16) float components[4][4];
+    for (int j = 0; j < 4; j++)
+      _mm_store_ps(components[j], projected[j]);
+    for (int lane = 0; lane < 4; lane++)
+    {
+      out[lane].projectedPosition = {components[0][lane], components[1][lane],
+                                     components[2][lane], components[3][lane]};
+    }
+  }
+#endif
+
+  for (; i < count; i++)
+    TransformPosition(&src[i], &dst[i]);
+}
+
+void TransformNormals(const InputVertexData* src, bool nbt, OutputVertexData* dst,
+                      std::size_t count)
+{
+  std::size_t i = 0;
+#ifdef _M_X86
+  for (; i + 4 <= count; i += 4)
+  {
+    const InputVertexData* in = &src[i];
+    OutputVertexData* out = &dst[i];
+    const float* const mats[4] = {&xfmem.normalMatrices[(in[0].posMtx & 31) * 3],
+                                  &xfmem.normalMatrices[(in[1].posMtx & 31) * 3],
+                                  &xfmem.normalMatrices[(in[2].posMtx & 31) * 3],
+                                  &xfmem.normalMatrices[(in[3].posMtx & 31) * 3]};
+
+    for (int n = 0; n < (nbt ? 3 : 1); n++)
+    {
+      __m128 normal[3];
+      __m128 result[3];
+      LoadVec3Lanes(in[0].normal[n], in[1].normal[n], in[2].normal[n], in[3].normal[n], normal);
+      MultiplyVec3Mat3x4Lanes<3>(normal, mats, result);
+      Vec3* const results[4] = {&out[0].normal[n], &out[1].normal[n], &out[2].normal[n],
+                                &out[3].normal[n]};
+      StoreVec3Lanes(result, results);
+    }
+
+    for (int lane = 0; lane < 4; lane++)
+      out[lane].normal[0].Normalize();
+  }
+#endif
+
+  for (; i < count; i++)
+    TransformNormal(&src[i], nbt, &dst[i]);
+}
+
 static void TransformTexCoordRegular(const TexMtxInfo& texinfo, int coordNum,
                                      const InputVertexData* srcVertex, OutputVertexData* dstVertex)
 {
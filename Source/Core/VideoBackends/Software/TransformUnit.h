@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 struct InputVertexData;
 struct OutputVertexData;
 
@@ -13,4 +15,9 @@ void TransformPosition(const InputVertexData* src, OutputVertexData* dst);
 void TransformNormal(const InputVertexData* src, bool nbt, OutputVertexData* dst);
 void TransformColor(const InputVertexData* src, OutputVertexData* dst);
 void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst);
+
+// Same as TransformPosition and TransformNormal for count vertices, several at a time.
+void TransformPositions(const InputVertexData* src, OutputVertexData* dst, std::size_t count);
+void TransformNormals(const InputVertexData* src, bool nbt, OutputVertexData* dst,
+                      std::size_t count);
 }  // namespace TransformUnit
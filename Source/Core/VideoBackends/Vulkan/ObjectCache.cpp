@@ -441,27 +441,6 @@ void ObjectCache::DestroyRenderPassCache()
   m_render_pass_cache.clear();
 }
 
-class PipelineCacheReadCallback : public LinearDiskCacheReader<u32, u8>
-{
-public:
-  PipelineCacheReadCallback(std::vector<u8>* data) : m_data(data) {}
-  void Read(const u32& key, const u8* value, u32 value_size) override
-  {
-    m_data->resize(value_size);
-    if (value_size > 0)
-      memcpy(m_data->data(), value, value_size);
-  }
-
-private:
-  std::vector<u8>* m_data;
-};
-
-class PipelineCacheReadIgnoreCallback : public LinearDiskCacheReader<u32, u8>
-{
-public:
-  void Read(const u32& key, const u8* value, u32 value_size) override {}
-};
-
 bool ObjectCache::CreatePipelineCache()
 {
   // Vulkan pipeline caches can be shared between games for shader compile time reduction.
@@ -492,15 +471,17 @@ bool ObjectCache::LoadPipelineCache()
   // we delete the old one, by which time the game's unique ID is already cleared.
   m_pipeline_cache_filename = GetDiskShaderCacheFileName(APIType::Vulkan, "Pipeline", false, true);
 
-  std::vector<u8> disk_data;
+  // The data is passed to the driver straight from the mapped file.
   LinearDiskCache<u32, u8> disk_cache;
-  PipelineCacheReadCallback read_callback(&disk_data);
-  if (disk_cache.OpenAndRead(m_pipeline_cache_filename, read_callback) != 1)
-    disk_data.clear();
+  u32 disk_data_size = 0;
+  const u8* disk_data = nullptr;
+  if (disk_cache.Open(m_pipeline_cache_filename) == 1)
+    disk_data = disk_cache.Lookup(1, &disk_data_size);
 
-  if (!disk_data.empty() && !ValidatePipelineCache(disk_data.data(), disk_data.size()))
+  if (disk_data && disk_data_size > 0 && !ValidatePipelineCache(disk_data, disk_data_size))
   {
     // Don't use this data. In fact, we should delete it to prevent it from being used next time.
+    disk_cache.Close();
     File::Delete(m_pipeline_cache_filename);
     return CreatePipelineCache();
   }
@@ -509,8 +490,8 @@ bool ObjectCache::LoadPipelineCache()
       VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,  // VkStructureType            sType
       nullptr,                                       // const void*                pNext
       0,                                             // VkPipelineCacheCreateFlags flags
-      disk_data.size(),                              // size_t                     initialDataSize
-      disk_data.data()                               // const void*                pInitialData
+      disk_data_size,                                // size_t                     initialDataSize
+      disk_data                                      // const void*                pInitialData
   };
 
   VkResult res =
@@ -620,8 +601,7 @@ void ObjectCache::SavePipelineCache()
   // Not ideal, but our disk cache class does not support just writing a single blob
   // of data without specifying a key.
   LinearDiskCache<u32, u8> disk_cache;
-  PipelineCacheReadIgnoreCallback callback;
-  disk_cache.OpenAndRead(m_pipeline_cache_filename, callback);
+  disk_cache.Open(m_pipeline_cache_filename);
   disk_cache.Append(1, data.data(), static_cast<u32>(data.size()));
   disk_cache.Close();
 }
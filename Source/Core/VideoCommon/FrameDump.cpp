@@ -8,8 +8,14 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -25,6 +31,7 @@ extern "C" {
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/HW/SystemTimers.h"
@@ -33,15 +40,28 @@ extern "C" {
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
+// Number of converted frames which can wait for the encoder at once.
+constexpr size_t SCALED_FRAME_COUNT = 3;
+
 struct FrameDumpContext
 {
   AVFormatContext* format = nullptr;
   AVStream* stream = nullptr;
   AVCodecContext* codec = nullptr;
   AVFrame* src_frame = nullptr;
-  AVFrame* scaled_frame = nullptr;
+  std::array<AVFrame*, SCALED_FRAME_COUNT> scaled_frames{};
   SwsContext* sws = nullptr;
 
+  // Frames are converted on the thread which adds them, and encoded and written on the encode
+  // thread, so that converting a frame overlaps with encoding the previous ones.
+  std::thread encode_thread;
+  std::mutex encode_lock;
+  std::condition_variable encode_cv;
+  // Both are protected by encode_lock.
+  std::vector<AVFrame*> free_frames;
+  std::queue<AVFrame*> encode_queue;
+  bool stop_encoding = false;
+
   s64 last_pts = AV_NOPTS_VALUE;
 
   int width = 0;
@@ -139,8 +159,11 @@ bool FrameDump::PrepareEncoding(int w, int h, u64 start_ticks, u32 savestate_ind
   {
     CloseVideoFile();
     OSD::AddMessage("FrameDump Start failed");
+    return false;
   }
-  return success;
+
+  m_context->encode_thread = std::thread(&FrameDump::EncodeThreadFunc, this);
+  return true;
 }
 
 bool FrameDump::CreateVideoFile()
@@ -214,9 +237,14 @@ bool FrameDump::CreateVideoFile()
   m_context->codec->height = m_context->height;
   m_context->codec->time_base = time_base;
   m_context->codec->gop_size = 1;
-  m_context->codec->level = 1;
+  // FFV1 version 1 can't be split into slices, which it needs to be encoded on several threads.
+  m_context->codec->level = codec->id == AV_CODEC_ID_FFV1 ? 3 : 1;
   m_context->codec->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGR0 : AV_PIX_FMT_YUV420P;
 
+  // Let FFmpeg pick the number of threads and the kinds of threading the encoder supports.
+  m_context->codec->thread_count = 0;
+  m_context->codec->thread_type = FF_THREAD_SLICE | FF_THREAD_FRAME;
+
   if (output_format->flags & AVFMT_GLOBALHEADER)
     m_context->codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 
@@ -227,14 +255,21 @@ bool FrameDump::CreateVideoFile()
   }
 
   m_context->src_frame = av_frame_alloc();
-  m_context->scaled_frame = av_frame_alloc();
+  for (AVFrame*& scaled_frame : m_context->scaled_frames)
+  {
+    scaled_frame = av_frame_alloc();
+    if (!scaled_frame)
+      return false;
 
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
-  m_context->scaled_frame->width = m_context->width;
-  m_context->scaled_frame->height = m_context->height;
+    scaled_frame->format = m_context->codec->pix_fmt;
+    scaled_frame->width = m_context->width;
+    scaled_frame->height = m_context->height;
 
-  if (av_frame_get_buffer(m_context->scaled_frame, 1))
-    return false;
+    if (av_frame_get_buffer(scaled_frame, 1))
+      return false;
+
+    m_context->free_frames.push_back(scaled_frame);
+  }
 
   m_context->stream = avformat_new_stream(m_context->format, codec);
   if (!m_context->stream ||
@@ -310,6 +345,24 @@ void FrameDump::AddFrame(const FrameData& frame)
   m_context->src_frame->width = m_context->width;
   m_context->src_frame->height = m_context->height;
 
+  // Wait for the encoder to catch up if all converted frames are still queued.
+  AVFrame* scaled_frame;
+  {
+    std::unique_lock<std::mutex> lk(m_context->encode_lock);
+    m_context->encode_cv.wait(lk, [this] { return !m_context->free_frames.empty(); });
+    scaled_frame = m_context->free_frames.back();
+    m_context->free_frames.pop_back();
+  }
+
+  // The encoder may still hold a reference to the buffers it was given with this frame earlier.
+  if (const int error = av_frame_make_writable(scaled_frame))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate frame: {}", error);
+    std::lock_guard<std::mutex> lk(m_context->encode_lock);
+    m_context->free_frames.push_back(scaled_frame);
+    return;
+  }
+
   // Convert image from RGBA to desired pixel format.
   m_context->sws = sws_getCachedContext(
       m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
@@ -317,19 +370,60 @@ void FrameDump::AddFrame(const FrameData& frame)
   if (m_context->sws)
   {
     sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+              frame.height, scaled_frame->data, scaled_frame->linesize);
   }
 
   m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
+  scaled_frame->pts = pts;
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
   {
-    ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", error);
-    return;
+    std::lock_guard<std::mutex> lk(m_context->encode_lock);
+    m_context->encode_queue.push(scaled_frame);
   }
+  m_context->encode_cv.notify_all();
+}
 
-  ProcessPackets();
+void FrameDump::EncodeThreadFunc()
+{
+  Common::SetCurrentThreadName("FrameDumpEncoder");
+
+  std::unique_lock<std::mutex> lk(m_context->encode_lock);
+  while (true)
+  {
+    m_context->encode_cv.wait(lk, [this] {
+      return !m_context->encode_queue.empty() || m_context->stop_encoding;
+    });
+
+    // Only stop once all queued frames have been encoded.
+    if (m_context->encode_queue.empty())
+      break;
+
+    AVFrame* const scaled_frame = m_context->encode_queue.front();
+    m_context->encode_queue.pop();
+    lk.unlock();
+
+    if (const int error = avcodec_send_frame(m_context->codec, scaled_frame))
+      ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", error);
+    else
+      ProcessPackets();
+
+    lk.lock();
+    m_context->free_frames.push_back(scaled_frame);
+    m_context->encode_cv.notify_all();
+  }
+}
+
+void FrameDump::StopEncodeThread()
+{
+  if (!m_context->encode_thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lk(m_context->encode_lock);
+    m_context->stop_encoding = true;
+  }
+  m_context->encode_cv.notify_all();
+  m_context->encode_thread.join();
 }
 
 void FrameDump::ProcessPackets()
@@ -369,6 +463,9 @@ void FrameDump::Stop()
   if (!IsStarted())
     return;
 
+  // Finish encoding the queued frames.
+  StopEncodeThread();
+
   // Signal end of stream to encoder.
   if (const int flush_error = avcodec_send_frame(m_context->codec, nullptr))
     WARN_LOG_FMT(FRAMEDUMP, "Error sending flush packet: {}", flush_error);
@@ -388,8 +485,11 @@ bool FrameDump::IsStarted() const
 
 void FrameDump::CloseVideoFile()
 {
+  StopEncodeThread();
+
   av_frame_free(&m_context->src_frame);
-  av_frame_free(&m_context->scaled_frame);
+  for (AVFrame*& scaled_frame : m_context->scaled_frames)
+    av_frame_free(&scaled_frame);
 
   avcodec_free_context(&m_context->codec);
 
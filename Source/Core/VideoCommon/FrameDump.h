@@ -53,6 +53,10 @@ private:
   void CheckForConfigChange(const FrameData&);
   void ProcessPackets();
 
+  // Encodes the frames converted by AddFrame, until StopEncodeThread is called.
+  void EncodeThreadFunc();
+  void StopEncodeThread();
+
 #if defined(HAVE_FFMPEG)
   std::unique_ptr<FrameDumpContext> m_context;
 #endif
@@ -110,6 +110,14 @@ struct SerializedGXUberPipelineUid
   u32 depth_state_bits;
   u32 blending_state_bits;
 };
+
+// Record of the first time a pipeline was used in a session, used to predict when it will be
+// needed in later sessions. The frame is counted from when the video backend started.
+struct SerializedGXPipelineUsage
+{
+  u32 frame;
+  SerializedGXPipelineUid uid;
+};
 #pragma pack(pop)
 
 }  // namespace VideoCommon
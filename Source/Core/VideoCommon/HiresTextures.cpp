@@ -5,31 +5,33 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <iterator>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
 
 #include <fmt/format.h>
 
+#include "Common/CPUDetect.h"
 #include "Common/CommonPaths.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
-#include "Common/Flag.h"
 #include "Common/IOFile.h"
 #include "Common/Image.h"
 #include "Common/Logging/Log.h"
-#include "Common/MemoryUtil.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
-#include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
@@ -40,14 +42,110 @@ struct DiskTexture
   bool has_arbitrary_mipmaps;
 };
 
+struct CachedTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  size_t size;
+  std::list<std::string>::iterator lru_position;
+  // Set for requested textures until Search returns them, so that they aren't evicted before the
+  // cache entry which is waiting for them picks them up.
+  bool awaiting_pickup;
+};
+
+struct LoadRequest
+{
+  std::string base_filename;
+  u32 width;
+  u32 height;
+};
+
 constexpr std::string_view s_format_prefix{"tex1_"};
 
 static std::unordered_map<std::string, DiskTexture> s_textureMap;
-static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
+
+// Loaded textures. Once they take up more than s_textureCacheBudget bytes, the least recently
+// used ones which aren't awaiting pickup are evicted.
+static std::unordered_map<std::string, CachedTexture> s_textureCache;
+static std::list<std::string> s_textureCacheLRU;
+static size_t s_textureCacheSize = 0;
+static size_t s_textureCacheBudget = 0;
 static std::mutex s_textureCacheMutex;
-static Common::Flag s_textureCacheAbortLoading;
 
-static std::thread s_prefetcher;
+// Textures requested by Search, the most recently requested one first. All the state below is
+// guarded by s_textureCacheMutex as well.
+static std::list<LoadRequest> s_loadQueue;
+static std::unordered_map<std::string, std::list<LoadRequest>::iterator> s_queuedTextures;
+static std::unordered_set<std::string> s_loadingTextures;
+static std::unordered_set<std::string> s_failedTextures;
+static std::condition_variable s_loadQueueChanged;
+static std::vector<std::thread> s_loaders;
+static bool s_stopLoaders = false;
+
+// Prefetching loads every texture while no texture is requested, until the budget is used up.
+static bool s_prefetching = false;
+static std::unordered_map<std::string, DiskTexture>::const_iterator s_prefetchIter;
+static u32 s_prefetchesInFlight = 0;
+static u32 s_prefetchStartTime = 0;
+
+static size_t GetTextureCacheBudget()
+{
+  return static_cast<size_t>(std::max(g_ActiveConfig.iHiresTexturesCacheSize, 0)) * 1024 * 1024;
+}
+
+static void RemoveFromTextureCache(std::unordered_map<std::string, CachedTexture>::iterator iter)
+{
+  s_textureCacheSize -= iter->second.size;
+  s_textureCacheLRU.erase(iter->second.lru_position);
+  s_textureCache.erase(iter);
+}
+
+static void ClearTextureCache()
+{
+  s_textureCache.clear();
+  s_textureCacheLRU.clear();
+  s_textureCacheSize = 0;
+}
+
+// Returns false if the texture was evicted right away, because it is a prefetched texture which
+// doesn't fit into the budget.
+static bool InsertIntoTextureCache(const std::string& base_filename,
+                                   std::shared_ptr<HiresTexture> texture, bool prefetched)
+{
+  size_t size = 0;
+  for (const HiresTexture::Level& level : texture->m_levels)
+    size += level.data.size();
+
+  // Prefetched textures haven't been used yet, so they are the first ones to be evicted.
+  const auto lru_position =
+      s_textureCacheLRU.insert(prefetched ? s_textureCacheLRU.end() : s_textureCacheLRU.begin(),
+                               base_filename);
+  s_textureCache.emplace(base_filename,
+                         CachedTexture{std::move(texture), size, lru_position, !prefetched});
+  s_textureCacheSize += size;
+
+  auto lru_iter = s_textureCacheLRU.end();
+  while (s_textureCacheSize > s_textureCacheBudget && lru_iter != s_textureCacheLRU.begin())
+  {
+    --lru_iter;
+    const auto cache_iter = s_textureCache.find(*lru_iter);
+    if (cache_iter->second.awaiting_pickup)
+      continue;
+
+    lru_iter = std::next(lru_iter);
+    RemoveFromTextureCache(cache_iter);
+  }
+
+  return s_textureCache.count(base_filename) != 0;
+}
+
+static void StopPrefetching()
+{
+  s_prefetching = false;
+  OSD::AddMessage(fmt::format("Custom Textures prefetching stopped after {:.1f} MB, the memory "
+                              "budget is used up",
+                              s_textureCacheSize / (1024.0 * 1024.0)),
+                  10000);
+}
 
 void HiresTexture::Init()
 {
@@ -61,11 +159,7 @@ void HiresTexture::Shutdown()
 
 void HiresTexture::Update()
 {
-  if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
-  }
+  StopLoaders();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
@@ -75,7 +169,7 @@ void HiresTexture::Update()
 
   if (!g_ActiveConfig.bCacheHiresTextures)
   {
-    s_textureCache.clear();
+    ClearTextureCache();
   }
 
   const std::string& game_id = SConfig::GetInstance().GetGameID();
@@ -117,101 +211,143 @@ void HiresTexture::Update()
     }
   }
 
-  if (g_ActiveConfig.bCacheHiresTextures)
+  // remove cached but deleted textures
+  auto iter = s_textureCache.begin();
+  while (iter != s_textureCache.end())
   {
-    // remove cached but deleted textures
-    auto iter = s_textureCache.begin();
-    while (iter != s_textureCache.end())
+    if (s_textureMap.find(iter->first) == s_textureMap.end())
     {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
-      {
-        iter = s_textureCache.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
+      auto next = std::next(iter);
+      RemoveFromTextureCache(iter);
+      iter = next;
+    }
+    else
+    {
+      iter++;
     }
-
-    s_textureCacheAbortLoading.Clear();
-    s_prefetcher = std::thread(Prefetch);
   }
+
+  // The textures may have been fixed since.
+  s_failedTextures.clear();
+
+  s_textureCacheBudget = GetTextureCacheBudget();
+  StartLoaders();
 }
 
 void HiresTexture::Clear()
 {
-  if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
-  }
+  StopLoaders();
   s_textureMap.clear();
-  s_textureCache.clear();
+  ClearTextureCache();
+  s_failedTextures.clear();
 }
 
-void HiresTexture::Prefetch()
+void HiresTexture::StartLoaders()
 {
-  Common::SetCurrentThreadName("Prefetcher");
+  s_prefetching = g_ActiveConfig.bCacheHiresTextures;
+  s_prefetchIter = s_textureMap.cbegin();
+  s_prefetchesInFlight = 0;
+  s_prefetchStartTime = Common::Timer::GetTimeMs();
+
+  const int num_loaders = std::max(cpu_info.num_cores - 1, 1);
+  for (int i = 0; i < num_loaders; i++)
+    s_loaders.emplace_back(LoaderThread);
+}
+
+void HiresTexture::StopLoaders()
+{
+  {
+    std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+    s_stopLoaders = true;
+  }
+  s_loadQueueChanged.notify_all();
+
+  // Textures which are being loaded are finished first, the remaining requests are dropped.
+  for (std::thread& loader : s_loaders)
+    loader.join();
+  s_loaders.clear();
 
-  size_t size_sum = 0;
-  const size_t sys_mem = Common::MemPhysical();
-  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
-  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  const size_t max_mem =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  s_stopLoaders = false;
+  s_loadQueue.clear();
+  s_queuedTextures.clear();
+  s_prefetching = false;
+}
+
+void HiresTexture::LoaderThread()
+{
+  Common::SetCurrentThreadName("Custom texture loader");
 
-  const u32 start_time = Common::Timer::GetTimeMs();
-  for (const auto& entry : s_textureMap)
+  std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+  while (true)
   {
-    const std::string& base_filename = entry.first;
+    s_loadQueueChanged.wait(lk,
+                            [] { return s_stopLoaders || !s_loadQueue.empty() || s_prefetching; });
+    if (s_stopLoaders)
+      return;
 
-    if (base_filename.find("_mip") == std::string::npos)
+    LoadRequest request;
+    const bool prefetch = s_loadQueue.empty();
+    if (!prefetch)
     {
-      std::unique_lock<std::mutex> lk(s_textureCacheMutex);
-
-      auto iter = s_textureCache.find(base_filename);
-      if (iter == s_textureCache.end())
+      request = std::move(s_loadQueue.front());
+      s_queuedTextures.erase(request.base_filename);
+      s_loadQueue.pop_front();
+    }
+    else if (s_textureCacheSize >= s_textureCacheBudget)
+    {
+      StopPrefetching();
+      continue;
+    }
+    else if (s_prefetchIter == s_textureMap.cend())
+    {
+      // Wait for the last textures to be loaded before reporting the time.
+      if (s_prefetchesInFlight != 0)
       {
-        // unlock while loading a texture. This may result in a race condition where
-        // we'll load a texture twice, but it reduces the stuttering a lot.
-        lk.unlock();
-        std::unique_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
-        lk.lock();
-        if (texture)
-        {
-          std::shared_ptr<HiresTexture> ptr(std::move(texture));
-          iter = s_textureCache.insert(iter, std::make_pair(base_filename, ptr));
-        }
+        s_loadQueueChanged.wait(lk);
+        continue;
       }
-      if (iter != s_textureCache.end())
+
+      s_prefetching = false;
+      const u32 stop_time = Common::Timer::GetTimeMs();
+      OSD::AddMessage(fmt::format("Custom Textures loaded, {:.1f} MB in {:.1f}s",
+                                  s_textureCacheSize / (1024.0 * 1024.0),
+                                  (stop_time - s_prefetchStartTime) / 1000.0),
+                      10000);
+      continue;
+    }
+    else
+    {
+      const std::string& base_filename = (s_prefetchIter++)->first;
+      if (base_filename.find("_mip") != std::string::npos ||
+          s_textureCache.count(base_filename) || s_loadingTextures.count(base_filename) ||
+          s_failedTextures.count(base_filename))
       {
-        for (const Level& l : iter->second->m_levels)
-          size_sum += l.data.size();
+        continue;
       }
+      request = {base_filename, 0, 0};
+      s_prefetchesInFlight++;
     }
 
-    if (s_textureCacheAbortLoading.IsSet())
+    s_loadingTextures.insert(request.base_filename);
+    lk.unlock();
+    std::unique_ptr<HiresTexture> texture =
+        Load(request.base_filename, request.width, request.height);
+    lk.lock();
+    s_loadingTextures.erase(request.base_filename);
+
+    if (!texture)
     {
-      return;
+      s_failedTextures.insert(request.base_filename);
     }
-
-    if (size_sum > max_mem)
+    else if (!InsertIntoTextureCache(request.base_filename, std::move(texture), prefetch) &&
+             s_prefetching)
     {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
-
-      OSD::AddMessage(
-          fmt::format(
-              "Custom Textures prefetching after {:.1f} MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
-          10000);
-      return;
+      StopPrefetching();
     }
-  }
 
-  const u32 stop_time = Common::Timer::GetTimeMs();
-  OSD::AddMessage(fmt::format("Custom Textures loaded, {:.1f} MB in {:.1f}s",
-                              size_sum / (1024.0 * 1024.0), (stop_time - start_time) / 1000.0),
-                  10000);
+    if (prefetch && --s_prefetchesInFlight == 0)
+      s_loadQueueChanged.notify_all();
+  }
 }
 
 std::string HiresTexture::GenBaseName(TextureInfo& texture_info, bool dump)
@@ -253,27 +389,50 @@ u32 HiresTexture::CalculateMipCount(u32 width, u32 height)
   return mip_count;
 }
 
-std::shared_ptr<HiresTexture> HiresTexture::Search(TextureInfo& texture_info)
+std::shared_ptr<HiresTexture> HiresTexture::Search(TextureInfo& texture_info,
+                                                   std::string* loading_base_filename)
 {
   const std::string base_filename = GenBaseName(texture_info);
+  if (base_filename.empty())
+    return nullptr;
 
   std::lock_guard<std::mutex> lk(s_textureCacheMutex);
 
   auto iter = s_textureCache.find(base_filename);
   if (iter != s_textureCache.end())
   {
-    return iter->second;
+    s_textureCacheLRU.splice(s_textureCacheLRU.begin(), s_textureCacheLRU,
+                             iter->second.lru_position);
+    iter->second.awaiting_pickup = false;
+    return iter->second.texture;
   }
 
-  std::shared_ptr<HiresTexture> ptr(
-      Load(base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight()));
+  if (s_failedTextures.count(base_filename))
+    return nullptr;
 
-  if (ptr && g_ActiveConfig.bCacheHiresTextures)
+  // Requested textures are loaded before the ones which were requested earlier, as they are the
+  // ones most likely to be visible right now.
+  auto queued_iter = s_queuedTextures.find(base_filename);
+  if (queued_iter != s_queuedTextures.end())
+  {
+    s_loadQueue.splice(s_loadQueue.begin(), s_loadQueue, queued_iter->second);
+  }
+  else if (!s_loadingTextures.count(base_filename))
   {
-    s_textureCache[base_filename] = ptr;
+    s_loadQueue.push_front(
+        {base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight()});
+    s_queuedTextures.emplace(base_filename, s_loadQueue.begin());
+    s_loadQueueChanged.notify_one();
   }
 
-  return ptr;
+  *loading_base_filename = base_filename;
+  return nullptr;
+}
+
+bool HiresTexture::IsLoading(const std::string& base_filename)
+{
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  return s_queuedTextures.count(base_filename) || s_loadingTextures.count(base_filename);
 }
 
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
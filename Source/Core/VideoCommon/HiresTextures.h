@@ -26,7 +26,14 @@ public:
   static void Clear();
   static void Shutdown();
 
-  static std::shared_ptr<HiresTexture> Search(TextureInfo& texture_info);
+  // Returns the custom texture replacing the given texture. Custom textures are loaded
+  // asynchronously, so nullptr is also returned when it hasn't been loaded yet. In that case,
+  // loading_base_filename is set to the name to pass to IsLoading.
+  static std::shared_ptr<HiresTexture> Search(TextureInfo& texture_info,
+                                              std::string* loading_base_filename);
+
+  // Whether a custom texture which Search returned nullptr for is still being loaded.
+  static bool IsLoading(const std::string& base_filename);
 
   static std::string GenBaseName(TextureInfo& texture_info, bool dump = false);
 
@@ -53,7 +60,9 @@ private:
   static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
   static bool LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
-  static void Prefetch();
+  static void StartLoaders();
+  static void StopLoaders();
+  static void LoaderThread();
 
   HiresTexture() {}
   bool m_has_arbitrary_mipmaps;
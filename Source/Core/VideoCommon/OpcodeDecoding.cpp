@@ -15,7 +15,11 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <unordered_map>
+#include <vector>
+
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/Memmap.h"
@@ -26,6 +30,7 @@
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace OpcodeDecoder
@@ -34,6 +39,73 @@ namespace
 {
 bool s_is_fifo_error_seen = false;
 
+// State changes in a display list still have to be executed every time it is called, but the
+// vertex loaders' output can be reused as long as the list is unchanged.
+struct CachedDisplayList
+{
+  u64 hash;
+  std::vector<VertexLoaderManager::CachedVertices> primitives;
+  size_t size = 0;
+};
+
+// Cached vertices are dropped once they take up this much memory.
+constexpr size_t DISPLAY_LIST_CACHE_BUDGET = 64 * 1024 * 1024;
+
+// Keyed by address and size.
+std::unordered_map<u64, CachedDisplayList> s_display_lists;
+size_t s_display_lists_size = 0;
+CachedDisplayList* s_current_display_list = nullptr;
+size_t s_current_primitive = 0;
+
+void ClearDisplayListCache()
+{
+  s_display_lists.clear();
+  s_display_lists_size = 0;
+}
+
+// Writes to memory can't be tracked from the GPU thread, so every call hashes the list's contents.
+CachedDisplayList* LookUpDisplayList(u32 address, u32 size, const u8* data)
+{
+  if (s_display_lists_size > DISPLAY_LIST_CACHE_BUDGET)
+    ClearDisplayListCache();
+
+  const u64 hash = Common::GetHash64(data, size, 0);
+  const auto [it, inserted] = s_display_lists.try_emplace((u64(address) << 32) | size);
+  CachedDisplayList& display_list = it->second;
+  if (!inserted && display_list.hash == hash)
+  {
+    INCSTAT(g_stats.this_frame.num_dlist_cache_hits);
+    return &display_list;
+  }
+
+  INCSTAT(g_stats.this_frame.num_dlist_cache_misses);
+  display_list.hash = hash;
+  display_list.primitives.clear();
+  return &display_list;
+}
+
+void UpdateCachedSize(CachedDisplayList* display_list)
+{
+  size_t size = 0;
+  for (const VertexLoaderManager::CachedVertices& primitive : display_list->primitives)
+    size += primitive.data.size();
+
+  s_display_lists_size = s_display_lists_size - display_list->size + size;
+  display_list->size = size;
+}
+
+VertexLoaderManager::CachedVertices* GetCachedPrimitive()
+{
+  if (!s_current_display_list)
+    return nullptr;
+
+  std::vector<VertexLoaderManager::CachedVertices>& primitives =
+      s_current_display_list->primitives;
+  if (s_current_primitive == primitives.size())
+    primitives.emplace_back();
+  return &primitives[s_current_primitive++];
+}
+
 u32 InterpretDisplayList(u32 address, u32 size)
 {
   u8* start_address;
@@ -51,9 +123,25 @@ u32 InterpretDisplayList(u32 address, u32 size)
     // temporarily swap dl and non-dl (small "hack" for the stats)
     g_stats.SwapDL();
 
+    if (g_ActiveConfig.bDisplayListCache)
+    {
+      s_current_display_list = LookUpDisplayList(address, size, start_address);
+      s_current_primitive = 0;
+    }
+    else if (!s_display_lists.empty())
+    {
+      ClearDisplayListCache();
+    }
+
     Run(DataReader(start_address, start_address + size), &cycles, true);
     INCSTAT(g_stats.this_frame.num_dlists_called);
 
+    if (s_current_display_list)
+    {
+      UpdateCachedSize(s_current_display_list);
+      s_current_display_list = nullptr;
+    }
+
     // un-swap
     g_stats.SwapDL();
   }
@@ -79,6 +167,7 @@ bool g_record_fifo_data = false;
 void Init()
 {
   s_is_fifo_error_seen = false;
+  ClearDisplayListCache();
 }
 
 template <bool is_preprocess>
@@ -241,9 +330,17 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
           return finish_up();
 
         const u16 num_vertices = src.Read<u16>();
+        VertexLoaderManager::CachedVertices* cached_vertices = nullptr;
+        if constexpr (!is_preprocess)
+        {
+          if (in_display_list)
+            cached_vertices = GetCachedPrimitive();
+        }
+
         const int bytes = VertexLoaderManager::RunVertices(
             cmd_byte & GX_VAT_MASK,  // Vertex loader index (0 - 7)
-            (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT, num_vertices, src, is_preprocess);
+            (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT, num_vertices, src, is_preprocess,
+            cached_vertices);
 
         if (bytes < 0)
           return finish_up();
@@ -0,0 +1,165 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/ParallelTextureDecoder.h"
+
+#include <algorithm>
+
+#include "Common/Thread.h"
+
+namespace VideoCommon
+{
+// Levels are only split into ranges of at least this many texels. Smaller ranges would spend
+// more time waking up threads than decoding.
+constexpr u32 MIN_TEXELS_PER_RANGE = 128 * 256;
+
+ParallelTextureDecoder::ParallelTextureDecoder(u32 num_threads)
+{
+  for (u32 i = 1; i < num_threads; i++)
+    m_workers.emplace_back(&ParallelTextureDecoder::WorkerThread, this);
+}
+
+ParallelTextureDecoder::~ParallelTextureDecoder()
+{
+  Finish();
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_exit = true;
+  }
+  m_range_queued.notify_all();
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+}
+
+u32 ParallelTextureDecoder::QueueLevel(u8* dst, const u8* src, int width, int height,
+                                       TextureFormat format, const u8* tlut,
+                                       TLUTFormat tlut_format)
+{
+  // Decoders work on whole blocks, so a level can only be split at block rows.
+  const int block_width = TexDecoder_GetBlockWidthInTexels(format);
+  const int block_height = TexDecoder_GetBlockHeightInTexels(format);
+  u32 num_ranges = 1;
+  u32 num_block_rows = 1;
+  if (width % block_width == 0 && height % block_height == 0)
+  {
+    num_block_rows = static_cast<u32>(height / block_height);
+    const u32 num_texels = static_cast<u32>(width * height);
+    num_ranges = std::clamp(num_texels / MIN_TEXELS_PER_RANGE, 1u,
+                            std::min(GetNumThreads(), num_block_rows));
+  }
+
+  std::unique_lock lk(m_mutex);
+  const u32 index = static_cast<u32>(m_levels.size());
+  m_levels.push_back({dst, src, width, height, format, tlut, tlut_format, num_ranges, num_ranges});
+
+  if (num_ranges == 1)
+  {
+    m_ranges.push_back({index, 0, num_block_rows});
+  }
+  else
+  {
+    for (u32 i = 0; i < num_ranges; i++)
+    {
+      const u32 first_row = num_block_rows * i / num_ranges;
+      const u32 end_row = num_block_rows * (i + 1) / num_ranges;
+      m_ranges.push_back({index, first_row, end_row - first_row});
+    }
+  }
+  lk.unlock();
+
+  // The waiting thread decodes one of the ranges itself.
+  if (num_ranges > 1)
+    m_range_queued.notify_all();
+  else
+    m_range_queued.notify_one();
+
+  return index;
+}
+
+void ParallelTextureDecoder::WaitForLevel(u32 index)
+{
+  std::unique_lock lk(m_mutex);
+  while (m_levels[index].ranges_left != 0)
+  {
+    // Ranges are queued in order, so the queued ranges belong to later levels when the front does.
+    // Only help with this level and the levels before it, to return as soon as possible.
+    if (!m_ranges.empty() && m_ranges.front().level <= index)
+      DecodeNextRange(lk);
+    else
+      m_level_done.wait(lk);
+  }
+}
+
+void ParallelTextureDecoder::Finish()
+{
+  for (u32 i = 0; i < static_cast<u32>(m_levels.size()); i++)
+    WaitForLevel(i);
+
+  std::lock_guard lk(m_mutex);
+  m_levels.clear();
+}
+
+void ParallelTextureDecoder::DecodeNextRange(std::unique_lock<std::mutex>& lock)
+{
+  const Range range = m_ranges.front();
+  m_ranges.pop_front();
+
+  // Copy the level, the vector may grow while the lock is released.
+  const Level level = m_levels[range.level];
+  lock.unlock();
+
+  if (level.num_ranges == 1)
+  {
+    TexDecoder_Decode(level.dst, level.src, level.width, level.height, level.format, level.tlut,
+                      level.tlut_format);
+  }
+  else
+  {
+    const int block_height = TexDecoder_GetBlockHeightInTexels(level.format);
+    const size_t src_row_pitch = static_cast<size_t>(TexDecoder_GetTextureSizeInBytes(
+        level.width, block_height, level.format));
+    const size_t dst_row_pitch = static_cast<size_t>(level.width) * block_height * sizeof(u32);
+    _TexDecoder_DecodeImpl(
+        reinterpret_cast<u32*>(level.dst + range.first_block_row * dst_row_pitch),
+        level.src + range.first_block_row * src_row_pitch, level.width,
+        static_cast<int>(range.num_block_rows) * block_height, level.format, level.tlut,
+        level.tlut_format);
+  }
+
+  lock.lock();
+  if (m_levels[range.level].ranges_left > 1)
+  {
+    m_levels[range.level].ranges_left--;
+    return;
+  }
+
+  // The overlay may cover several ranges, so it is drawn once all of them are decoded.
+  if (level.num_ranges > 1)
+  {
+    lock.unlock();
+    TexDecoder_DrawOverlay(level.dst, level.width, level.height, level.format);
+    lock.lock();
+  }
+
+  m_levels[range.level].ranges_left = 0;
+  m_level_done.notify_all();
+}
+
+void ParallelTextureDecoder::WorkerThread()
+{
+  Common::SetCurrentThreadName("Texture decoder");
+
+  std::unique_lock lk(m_mutex);
+  while (true)
+  {
+    m_range_queued.wait(lk, [this] { return m_exit || !m_ranges.empty(); });
+    if (m_exit)
+      break;
+
+    DecodeNextRange(lk);
+  }
+}
+}  // namespace VideoCommon
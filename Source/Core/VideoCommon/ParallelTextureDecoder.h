@@ -0,0 +1,82 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace VideoCommon
+{
+// Decodes texture levels on a pool of worker threads. Large levels are split into ranges of
+// block rows, so that several threads can decode one level, and the levels of a mipmap chain are
+// decoded concurrently. The thread waiting for a level decodes ranges too, so a decoder with one
+// thread decodes everything on the waiting thread.
+class ParallelTextureDecoder
+{
+public:
+  explicit ParallelTextureDecoder(u32 num_threads);
+  ~ParallelTextureDecoder();
+
+  ParallelTextureDecoder(const ParallelTextureDecoder&) = delete;
+  ParallelTextureDecoder& operator=(const ParallelTextureDecoder&) = delete;
+
+  // Number of threads decoding, including the waiting thread.
+  u32 GetNumThreads() const { return static_cast<u32>(m_workers.size()) + 1; }
+
+  // Queues decoding of a level, with the same arguments as TexDecoder_Decode. The buffers must
+  // stay valid until the level has been waited for. Returns the index to wait for the level with.
+  // Levels are decoded in the order they were queued.
+  u32 QueueLevel(u8* dst, const u8* src, int width, int height, TextureFormat format,
+                 const u8* tlut, TLUTFormat tlut_format);
+
+  // Waits until the specified level has been decoded.
+  void WaitForLevel(u32 index);
+
+  // Waits until all queued levels have been decoded. Indices start at zero again afterwards.
+  void Finish();
+
+private:
+  struct Level
+  {
+    u8* dst;
+    const u8* src;
+    int width;
+    int height;
+    TextureFormat format;
+    const u8* tlut;
+    TLUTFormat tlut_format;
+
+    u32 num_ranges;
+    u32 ranges_left;
+  };
+
+  struct Range
+  {
+    u32 level;
+    u32 first_block_row;
+    u32 num_block_rows;
+  };
+
+  // Decodes the next queued range. The lock is released while decoding.
+  void DecodeNextRange(std::unique_lock<std::mutex>& lock);
+  void WorkerThread();
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_range_queued;
+  std::condition_variable m_level_done;
+
+  // Both are protected by m_mutex.
+  std::vector<Level> m_levels;
+  std::deque<Range> m_ranges;
+  bool m_exit = false;
+};
+}  // namespace VideoCommon
@@ -1430,12 +1430,15 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  // The dump thread may still be reading the frame which was last read back into this buffer.
+  FrameDumpBuffer& buffer = m_frame_dump_buffers[m_frame_dump_buffer_index];
+  FinishFrameData(buffer);
+  if (!CheckFrameDumpReadbackTexture(buffer, target_width, target_height))
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_frame_dump.FetchState(ticks, frame_number);
+  buffer.readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
+                                           buffer.readback_texture->GetRect());
+  buffer.state = m_frame_dump.FetchState(ticks, frame_number);
   m_frame_dump_needs_flush = true;
 }
 
@@ -1465,9 +1468,10 @@ bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
   return true;
 }
 
-bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool Renderer::CheckFrameDumpReadbackTexture(FrameDumpBuffer& buffer, u32 target_width,
+                                             u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex = buffer.readback_texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -1486,25 +1490,17 @@ void Renderer::FlushFrameDump()
   if (!m_frame_dump_needs_flush)
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
-
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  // Queue encoding of the last frame dumped, and read the next one back into the next buffer.
+  const u32 buffer_index = m_frame_dump_buffer_index;
+  m_frame_dump_buffer_index = (m_frame_dump_buffer_index + 1) % FRAME_DUMP_BUFFER_COUNT;
+  m_frame_dump_needs_flush = false;
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
+  auto& output = m_frame_dump_buffers[buffer_index].readback_texture;
   output->Flush();
   if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
+    DumpFrameData(buffer_index);
   else
-  {
     ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
-
-  m_frame_dump_needs_flush = false;
 
   // Shutdown frame dumping if it is no longer active.
   if (!IsFrameDumping())
@@ -1519,7 +1515,7 @@ void Renderer::ShutdownFrameDumping()
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  // Ensure previous frame has been encoded.
+  // Ensure all queued frames have been encoded.
   FinishFrameData();
 
   // Wake thread up, and wait for it to exit.
@@ -1530,13 +1526,25 @@ void Renderer::ShutdownFrameDumping()
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  for (FrameDumpBuffer& buffer : m_frame_dump_buffers)
+    buffer.readback_texture.reset();
+  m_frame_dump_buffer_index = 0;
 }
 
-void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
+void Renderer::DumpFrameData(u32 buffer_index)
 {
-  m_frame_dump_data = FrameDump::FrameData{data, w, h, stride, m_last_frame_state};
+  FrameDumpBuffer& buffer = m_frame_dump_buffers[buffer_index];
+  const AbstractStagingTexture* texture = buffer.readback_texture.get();
+  buffer.queued = true;
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_queue_lock);
+    m_frame_dump_queue.emplace(
+        buffer_index,
+        FrameDump::FrameData{reinterpret_cast<const u8*>(texture->GetMappedPointer()),
+                             static_cast<int>(texture->GetConfig().width),
+                             static_cast<int>(texture->GetConfig().height),
+                             static_cast<int>(texture->GetMappedStride()), buffer.state});
+  }
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -1548,18 +1556,27 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
 
   // Wake worker thread up.
   m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
 }
 
-void Renderer::FinishFrameData()
+void Renderer::FinishFrameData(FrameDumpBuffer& buffer)
 {
-  if (!m_frame_dump_frame_running)
+  if (!buffer.queued)
     return;
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  buffer.done.Wait();
+  buffer.queued = false;
+
+  buffer.readback_texture->Unmap();
+}
 
-  m_frame_dump_output_texture->Unmap();
+void Renderer::FinishFrameData()
+{
+  // Frames are dumped in the order they were queued, starting with the oldest buffer.
+  for (u32 i = 0; i < FRAME_DUMP_BUFFER_COUNT; i++)
+  {
+    const u32 buffer_index = (m_frame_dump_buffer_index + i) % FRAME_DUMP_BUFFER_COUNT;
+    FinishFrameData(m_frame_dump_buffers[buffer_index]);
+  }
 }
 
 void Renderer::FrameDumpThreadFunc()
@@ -1581,11 +1598,20 @@ void Renderer::FrameDumpThreadFunc()
 
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+    std::unique_lock<std::mutex> lk(m_frame_dump_queue_lock);
+    if (m_frame_dump_queue.empty())
+    {
+      lk.unlock();
+      if (!m_frame_dump_thread_running.IsSet())
+        break;
+
+      m_frame_dump_start.Wait();
+      continue;
+    }
 
-    auto frame = m_frame_dump_data;
+    const auto [buffer_index, frame] = m_frame_dump_queue.front();
+    m_frame_dump_queue.pop();
+    lk.unlock();
 
     // Save screenshot
     if (m_screenshot_request.TestAndClear())
@@ -1624,7 +1650,7 @@ void Renderer::FrameDumpThreadFunc()
       }
     }
 
-    m_frame_dump_done.Set();
+    m_frame_dump_buffers[buffer_index].done.Set();
   }
 
   if (frame_dump_started)
@@ -17,10 +17,12 @@
 #include <array>
 #include <memory>
 #include <mutex>
+#include <queue>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -358,26 +360,36 @@ private:
   // Used to kick frame dump thread.
   Common::Event m_frame_dump_start;
 
-  // Set by frame dump thread on frame completion.
-  Common::Event m_frame_dump_done;
-
-  // Holds emulation state during the last swap when dumping.
-  FrameDump::FrameState m_last_frame_state;
-
-  // Communication of frame between video and dump threads.
-  FrameDump::FrameData m_frame_dump_data;
-
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
+  // Frames are read back into these buffers in turn. A buffer stays mapped until the dump thread
+  // is done with its frame, so the video thread only waits for the dump thread when it falls
+  // behind by more than FRAME_DUMP_BUFFER_COUNT frames.
+  static constexpr u32 FRAME_DUMP_BUFFER_COUNT = 4;
+  struct FrameDumpBuffer
+  {
+    std::unique_ptr<AbstractStagingTexture> readback_texture;
+
+    // Holds emulation state during the swap which was read back.
+    FrameDump::FrameState state;
+
+    // Set by frame dump thread when it no longer needs the mapped texture.
+    Common::Event done;
+
+    // Set when the texture is mapped and queued for the frame dump thread.
+    bool queued = false;
+  };
+  std::array<FrameDumpBuffer, FRAME_DUMP_BUFFER_COUNT> m_frame_dump_buffers;
+  // Buffer which the next frame is read back into.
+  u32 m_frame_dump_buffer_index = 0;
+  // Set when the current buffer holds a frame that needs to be dumped.
   bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+
+  // Communication of frames between video and dump threads, in the order they were rendered.
+  std::mutex m_frame_dump_queue_lock;
+  std::queue<std::pair<u32, FrameDump::FrameData>> m_frame_dump_queue;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
@@ -406,20 +418,24 @@ private:
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Checks that the readback texture of a frame dump buffer exists and is the correct size.
+  bool CheckFrameDumpReadbackTexture(FrameDumpBuffer& buffer, u32 target_width,
+                                     u32 target_height);
 
   // Fills the frame dump staging texture with the current XFB texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect, u64 ticks, int frame_number);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Asynchronously encodes the mapped texture of the specified buffer to the frame dump.
+  void DumpFrameData(u32 buffer_index);
 
   // Ensures all rendered frames are queued for encoding.
   void FlushFrameDump();
 
-  // Ensures all encoded frames have been written to the output file.
+  // Waits for the dump thread to finish with the frame in the specified buffer.
+  void FinishFrameData(FrameDumpBuffer& buffer);
+
+  // Waits for the dump thread to finish with all queued frames.
   void FinishFrameData();
 
   std::unique_ptr<NetPlayChatUI> m_netplay_chat_ui;
@@ -4,9 +4,14 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/FramebufferManager.h"
@@ -24,6 +29,17 @@ std::unique_ptr<VideoCommon::ShaderCache> g_shader_cache;
 
 namespace VideoCommon
 {
+// Number of pipelines predicted from the trace which may be compiling at once, so that compiling
+// ahead doesn't hold up pipelines the game needs right away.
+constexpr size_t MAX_PREDICTED_PIPELINES_IN_FLIGHT = 16;
+
+// When a traced pipeline is used, the pipelines which were first used within this many frames
+// after it are queued right away, regardless of the limit above.
+constexpr u32 PREDICTION_WINDOW_FRAMES = 120;
+
+constexpr u32 PIPELINE_TRACE_FILE_MAGIC = 0x52545550;  // PUTR
+constexpr size_t PIPELINE_TRACE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+
 ShaderCache::ShaderCache() : m_api_type{APIType::Nothing}
 {
 }
@@ -54,6 +70,8 @@ void ShaderCache::InitializeShaderCache()
   {
     LoadCaches();
     LoadPipelineUIDCache();
+    if (g_ActiveConfig.bPredictiveShaderCompilation)
+      LoadPipelineTrace();
   }
 
   // Queue ubershader precompiling if required.
@@ -75,15 +93,20 @@ void ShaderCache::Reload()
   ClosePipelineUIDCache();
   ClearCaches();
 
+  // The pipelines were destroyed, so go through the trace again.
+  m_predicted_pipelines.clear();
+  m_pipeline_trace_cursor = 0;
+  m_pipeline_trace_wrapped = false;
+
   if (!CompileSharedPipelines())
     PanicAlertFmt("Failed to compile shared pipelines after reload.");
 
-  if (g_ActiveConfig.bShaderCache)
-    LoadCaches();
-
   // Switch to the precompiling shader configuration while we rebuild.
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
 
+  if (g_ActiveConfig.bShaderCache)
+    LoadCaches();
+
   // We don't need to explicitly recompile the individual ubershaders here, as the pipelines
   // UIDs are still be in the map. Therefore, when these are rebuilt, the shaders will also
   // be recompiled.
@@ -96,6 +119,11 @@ void ShaderCache::Reload()
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+
+  // This is called once per frame, so it also serves as the clock for the pipeline trace.
+  m_frame_number++;
+  if (m_predicting_pipelines)
+    QueuePredictedPipelines();
 }
 
 void ShaderCache::Shutdown()
@@ -106,10 +134,13 @@ void ShaderCache::Shutdown()
     m_async_shader_compiler->StopWorkerThreads();
 
   ClosePipelineUIDCache();
+  SavePipelineTrace();
 }
 
 const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 {
+  NotePipelineUse(uid);
+
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
@@ -126,6 +157,8 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 
 std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid)
 {
+  NotePipelineUse(uid);
+
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end())
   {
@@ -210,44 +243,91 @@ static void UnserializePipelineUid(const SerializedUidType& uid, UidType& real_u
   real_uid.blending_state.hex = uid.blending_state_bits;
 }
 
+template <ShaderStage stage, typename K, typename T>
+static void InsertCachedShader(T& cache, const K& key, std::unique_ptr<AbstractShader> shader)
+{
+  if (!shader)
+  {
+    // Leave it to be compiled from source once it is needed.
+    auto it = cache.shader_map.find(key);
+    if (it != cache.shader_map.end() && !it->second.shader)
+      cache.shader_map.erase(it);
+    return;
+  }
+
+  auto& entry = cache.shader_map[key];
+  entry.pending = false;
+  if (entry.shader)
+    return;
+
+  entry.shader = std::move(shader);
+  switch (stage)
+  {
+  case ShaderStage::Vertex:
+    INCSTAT(g_stats.num_vertex_shaders_created);
+    INCSTAT(g_stats.num_vertex_shaders_alive);
+    break;
+  case ShaderStage::Pixel:
+    INCSTAT(g_stats.num_pixel_shaders_created);
+    INCSTAT(g_stats.num_pixel_shaders_alive);
+    break;
+  default:
+    break;
+  }
+}
+
 template <ShaderStage stage, typename K, typename T>
 void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid)
 {
+  class ShaderLoadWorkItem final : public AsyncShaderCompiler::WorkItem
+  {
+  public:
+    ShaderLoadWorkItem(T& cache_, const K& key_, const u8* value, u32 value_size)
+        : cache(cache_), key(key_), binary(value, value + value_size)
+    {
+    }
+
+    bool Compile() override
+    {
+      shader = g_renderer->CreateShaderFromBinary(stage, binary.data(), binary.size());
+      return true;
+    }
+
+    void Retrieve() override { InsertCachedShader<stage>(cache, key, std::move(shader)); }
+
+  private:
+    T& cache;
+    K key;
+    std::vector<u8> binary;
+    std::unique_ptr<AbstractShader> shader;
+  };
+
   class CacheReader : public LinearDiskCacheReader<K, u8>
   {
   public:
-    CacheReader(T& cache_) : cache(cache_) {}
+    CacheReader(T& cache_, AsyncShaderCompiler* compiler_) : cache(cache_), compiler(compiler_) {}
     void Read(const K& key, const u8* value, u32 value_size)
     {
-      auto shader = g_renderer->CreateShaderFromBinary(stage, value, value_size);
-      if (shader)
+      if (!compiler)
       {
-        auto& entry = cache.shader_map[key];
-        entry.shader = std::move(shader);
-        entry.pending = false;
-
-        switch (stage)
-        {
-        case ShaderStage::Vertex:
-          INCSTAT(g_stats.num_vertex_shaders_created);
-          INCSTAT(g_stats.num_vertex_shaders_alive);
-          break;
-        case ShaderStage::Pixel:
-          INCSTAT(g_stats.num_pixel_shaders_created);
-          INCSTAT(g_stats.num_pixel_shaders_alive);
-          break;
-        default:
-          break;
-        }
+        InsertCachedShader<stage>(cache, key,
+                                  g_renderer->CreateShaderFromBinary(stage, value, value_size));
+        return;
       }
+
+      cache.shader_map[key].pending = true;
+      auto wi = compiler->CreateWorkItem<ShaderLoadWorkItem>(cache, key, value, value_size);
+      compiler->QueueWorkItem(std::move(wi), GetCacheLoadPriority(num_read++));
     }
 
   private:
     T& cache;
+    AsyncShaderCompiler* compiler;
+    u32 num_read = 0;
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
-  CacheReader reader(cache);
+  CacheReader reader(cache, GetCacheLoadCompiler());
   u32 count = cache.disk_cache.OpenAndRead(filename, reader);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
 }
@@ -264,10 +344,49 @@ template <typename KeyType, typename DiskKeyType, typename T>
 void ShaderCache::LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>& disk_cache,
                                     APIType api_type, const char* type, bool include_gameid)
 {
+  class PipelineLoadWorkItem final : public AsyncShaderCompiler::WorkItem
+  {
+  public:
+    PipelineLoadWorkItem(T& cache_, const KeyType& uid_, const AbstractPipelineConfig& config_,
+                         const u8* value, u32 value_size, bool* failed_)
+        : cache(cache_), uid(uid_), config(config_), data(value, value + value_size),
+          failed(failed_)
+    {
+    }
+
+    bool Compile() override
+    {
+      pipeline = g_renderer->CreatePipeline(config, data.data(), data.size());
+      return true;
+    }
+
+    void Retrieve() override
+    {
+      // Pipelines which failed to create are left empty, so they are compiled from scratch.
+      auto& entry = cache[uid];
+      entry.second = false;
+      if (!pipeline)
+        *failed = true;
+      else if (!entry.first)
+        entry.first = std::move(pipeline);
+    }
+
+  private:
+    T& cache;
+    KeyType uid;
+    AbstractPipelineConfig config;
+    std::vector<u8> data;
+    bool* failed;
+    std::unique_ptr<AbstractPipeline> pipeline;
+  };
+
   class CacheReader : public LinearDiskCacheReader<DiskKeyType, u8>
   {
   public:
-    CacheReader(ShaderCache* this_ptr_, T& cache_) : this_ptr(this_ptr_), cache(cache_) {}
+    CacheReader(ShaderCache* this_ptr_, T& cache_, AsyncShaderCompiler* compiler_)
+        : this_ptr(this_ptr_), cache(cache_), compiler(compiler_)
+    {
+    }
     bool AnyFailed() const { return failed; }
     void Read(const DiskKeyType& key, const u8* value, u32 value_size)
     {
@@ -282,6 +401,15 @@ void ShaderCache::LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>&
       if (!config)
         return;
 
+      if (compiler)
+      {
+        cache[real_uid].second = true;
+        auto wi = compiler->CreateWorkItem<PipelineLoadWorkItem>(cache, real_uid, *config, value,
+                                                                 value_size, &failed);
+        compiler->QueueWorkItem(std::move(wi), GetCacheLoadPriority(num_read++));
+        return;
+      }
+
       auto pipeline = g_renderer->CreatePipeline(*config, value, value_size);
       if (!pipeline)
       {
@@ -298,14 +426,20 @@ void ShaderCache::LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>&
   private:
     ShaderCache* this_ptr;
     T& cache;
+    AsyncShaderCompiler* compiler;
+    u32 num_read = 0;
     bool failed = false;
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
-  CacheReader reader(this, cache);
+  CacheReader reader(this, cache, GetCacheLoadCompiler());
   const u32 count = disk_cache.OpenAndRead(filename, reader);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached pipelines from {}", count, filename);
 
+  // The pipelines have to be created before we know whether any of them failed.
+  if (GetCacheLoadCompiler())
+    WaitForAsyncCompiler();
+
   // If any of the pipelines in the cache failed to create, it's likely because of a change of
   // driver version, or system configuration. In this case, when the UID cache picks up the pipeline
   // later on, we'll write a duplicate entry to the pipeline cache. There's also no point in keeping
@@ -334,8 +468,25 @@ void ShaderCache::ClearPipelineCache(T& cache, Y& disk_cache)
   }
 }
 
+AsyncShaderCompiler* ShaderCache::GetCacheLoadCompiler() const
+{
+  if (!g_ActiveConfig.bParallelShaderCacheLoading || !m_async_shader_compiler->HasWorkerThreads())
+    return nullptr;
+
+  return m_async_shader_compiler.get();
+}
+
+u32 ShaderCache::GetCacheLoadPriority(u32 entry_index)
+{
+  // Entries are appended to the caches as they are first used, so the last ones belong to what
+  // was played most recently. Create those first.
+  return std::numeric_limits<u32>::max() - entry_index;
+}
+
 void ShaderCache::LoadCaches()
 {
+  const u64 start_time = Common::Timer::GetTimeUs();
+
   // Ubershader caches, if present.
   if (g_ActiveConfig.backend_info.bSupportsShaderBinaries)
   {
@@ -354,6 +505,10 @@ void ShaderCache::LoadCaches()
                                                           true);
     LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(m_ps_cache, m_api_type, "specialized-ps",
                                                         true);
+
+    // The pipelines are created from these shaders, so they have to be ready first.
+    if (GetCacheLoadCompiler())
+      WaitForAsyncCompiler();
   }
 
   if (g_ActiveConfig.backend_info.bSupportsPipelineCacheData)
@@ -364,6 +519,10 @@ void ShaderCache::LoadCaches()
         m_gx_uber_pipeline_cache, m_gx_uber_pipeline_disk_cache, m_api_type, "uber-pipeline",
         false);
   }
+
+  INFO_LOG_FMT(VIDEO, "Loaded shader caches in {} ms{}",
+               (Common::Timer::GetTimeUs() - start_time) / 1000,
+               GetCacheLoadCompiler() ? " using the precompiler threads" : "");
 }
 
 void ShaderCache::ClearCaches()
@@ -402,11 +561,18 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  // Queue all uids with a null pipeline for compilation. When predicting, the traced pipelines
+  // which haven't been used yet are left to QueuePredictedPipelines().
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
-      QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+    if (it.second.first)
+      continue;
+    if (m_predicting_pipelines && m_pipeline_trace_indices.count(it.first) != 0 &&
+        m_session_used_pipelines.count(it.first) == 0)
+    {
+      continue;
+    }
+    QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
   }
   for (auto& it : m_gx_uber_pipeline_cache)
   {
@@ -801,6 +967,152 @@ void ShaderCache::ClosePipelineUIDCache()
   m_gx_pipeline_uid_cache_file.Close();
 }
 
+void ShaderCache::LoadPipelineTrace()
+{
+  m_pipeline_trace_filename =
+      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".pipelinetrace";
+
+  // Compiling ahead only helps if there are threads to do it on while the game is running.
+  m_predicting_pipelines = !g_ActiveConfig.bWaitForShadersBeforeStarting &&
+                           g_ActiveConfig.GetShaderCompilerThreads() > 0;
+
+  File::IOFile file(m_pipeline_trace_filename, "rb");
+  u32 magic;
+  u32 version;
+  if (!file.ReadBytes(&magic, sizeof(magic)) || !file.ReadBytes(&version, sizeof(version)) ||
+      magic != PIPELINE_TRACE_FILE_MAGIC || version != GX_PIPELINE_UID_VERSION)
+  {
+    return;
+  }
+
+  // A partially written record at the end is ignored.
+  const size_t count = static_cast<size_t>((file.GetSize() - PIPELINE_TRACE_HEADER_SIZE) /
+                                           sizeof(SerializedGXPipelineUsage));
+  std::vector<SerializedGXPipelineUsage> records(count);
+  if (!file.ReadArray(records.data(), count))
+    return;
+
+  m_pipeline_trace.reserve(count);
+  for (const SerializedGXPipelineUsage& record : records)
+  {
+    GXPipelineUid uid;
+    UnserializePipelineUid(record.uid, uid);
+    if (m_pipeline_trace_indices.emplace(uid, m_pipeline_trace.size()).second)
+      m_pipeline_trace.push_back({uid, record.frame});
+  }
+
+  INFO_LOG_FMT(VIDEO, "Read {} pipeline uses from {}", m_pipeline_trace.size(),
+               m_pipeline_trace_filename);
+}
+
+void ShaderCache::SavePipelineTrace()
+{
+  // Keep the previous trace if nothing was recorded, e.g. when the game failed to boot.
+  if (m_session_pipeline_trace.empty())
+    return;
+
+  // The pipelines used in this session come first, in order. Pipelines which were only used in
+  // previous sessions are kept after them, so that they are still compiled eventually.
+  const std::string temp_filename = m_pipeline_trace_filename + ".tmp";
+  File::IOFile file(temp_filename, "wb");
+  bool success = file.WriteBytes(&PIPELINE_TRACE_FILE_MAGIC, sizeof(PIPELINE_TRACE_FILE_MAGIC)) &&
+                 file.WriteBytes(&GX_PIPELINE_UID_VERSION, sizeof(GX_PIPELINE_UID_VERSION)) &&
+                 file.WriteArray(m_session_pipeline_trace.data(), m_session_pipeline_trace.size());
+  for (const PipelineTraceEntry& entry : m_pipeline_trace)
+  {
+    if (!success)
+      break;
+    if (m_session_used_pipelines.count(entry.uid) != 0)
+      continue;
+
+    SerializedGXPipelineUsage record;
+    record.frame = entry.frame;
+    SerializePipelineUid(entry.uid, record.uid);
+    success = file.WriteBytes(&record, sizeof(record));
+  }
+  file.Close();
+
+  if (!success || !File::Rename(temp_filename, m_pipeline_trace_filename))
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to write pipeline trace to {}", m_pipeline_trace_filename);
+    File::Delete(temp_filename);
+  }
+
+  m_session_pipeline_trace.clear();
+  m_session_used_pipelines.clear();
+}
+
+void ShaderCache::NotePipelineUse(const GXPipelineUid& uid)
+{
+  // The file name is only set when predictive compilation is enabled.
+  if (m_pipeline_trace_filename.empty() || !m_session_used_pipelines.insert(uid).second)
+    return;
+
+  SerializedGXPipelineUsage record;
+  record.frame = m_frame_number;
+  SerializePipelineUid(uid, record.uid);
+  m_session_pipeline_trace.push_back(record);
+
+  if (!m_predicting_pipelines)
+    return;
+  const auto it = m_pipeline_trace_indices.find(uid);
+  if (it == m_pipeline_trace_indices.end())
+    return;
+
+  // The game got to this point of the trace, so the pipelines which followed are likely to be
+  // needed soon. Pipelines which were skipped over are picked up on the second pass.
+  const size_t index = it->second;
+  const u32 frame = m_pipeline_trace[index].frame;
+  m_pipeline_trace_cursor = std::max(m_pipeline_trace_cursor, index + 1);
+  for (size_t i = index + 1; i < m_pipeline_trace.size(); i++)
+  {
+    const PipelineTraceEntry& entry = m_pipeline_trace[i];
+    if (entry.frame < frame || entry.frame - frame > PREDICTION_WINDOW_FRAMES)
+      break;
+    QueuePredictedPipeline(entry.uid);
+  }
+}
+
+bool ShaderCache::QueuePredictedPipeline(const GXPipelineUid& uid)
+{
+  // Skip pipelines which are already compiled or compiling.
+  const auto it = m_gx_pipeline_cache.find(uid);
+  if (it != m_gx_pipeline_cache.end() && (it->second.first || it->second.second))
+    return false;
+
+  QueuePipelineCompile(uid, COMPILE_PRIORITY_PREDICTED_PIPELINE);
+  m_predicted_pipelines.push_back(uid);
+  return true;
+}
+
+void ShaderCache::QueuePredictedPipelines()
+{
+  // Forget about the pipelines which finished compiling.
+  m_predicted_pipelines.erase(
+      std::remove_if(m_predicted_pipelines.begin(), m_predicted_pipelines.end(),
+                     [this](const GXPipelineUid& uid) {
+                       const auto it = m_gx_pipeline_cache.find(uid);
+                       return it == m_gx_pipeline_cache.end() || !it->second.second;
+                     }),
+      m_predicted_pipelines.end());
+
+  while (m_predicted_pipelines.size() < MAX_PREDICTED_PIPELINES_IN_FLIGHT)
+  {
+    if (m_pipeline_trace_cursor == m_pipeline_trace.size())
+    {
+      if (m_pipeline_trace_wrapped)
+        return;
+
+      // Go through the trace a second time for the pipelines the game skipped over.
+      m_pipeline_trace_wrapped = true;
+      m_pipeline_trace_cursor = 0;
+      continue;
+    }
+
+    QueuePredictedPipeline(m_pipeline_trace[m_pipeline_trace_cursor++].uid);
+  }
+}
+
 void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 {
   GXPipelineUid real_uid;
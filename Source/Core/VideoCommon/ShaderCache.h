@@ -10,9 +10,11 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -117,10 +119,16 @@ private:
   static constexpr size_t NUM_PALETTE_CONVERSION_SHADERS = 3;
 
   void WaitForAsyncCompiler();
+  // Returns the compiler to create cached shaders and pipelines with when loading them in
+  // parallel, or null if they should be created right away.
+  AsyncShaderCompiler* GetCacheLoadCompiler() const;
+  static u32 GetCacheLoadPriority(u32 entry_index);
   void LoadCaches();
   void ClearCaches();
   void LoadPipelineUIDCache();
   void ClosePipelineUIDCache();
+  void LoadPipelineTrace();
+  void SavePipelineTrace();
   void CompileMissingPipelines();
   void QueueUberShaderPipelines();
   bool CompileSharedPipelines();
@@ -161,6 +169,11 @@ private:
   void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
   void AppendGXPipelineUID(const GXPipelineUid& config);
 
+  // Predictive pipeline compilation
+  void NotePipelineUse(const GXPipelineUid& uid);
+  bool QueuePredictedPipeline(const GXPipelineUid& uid);
+  void QueuePredictedPipelines();
+
   // ASync Compiler Methods
   void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
   void QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority);
@@ -183,10 +196,12 @@ private:
   // Priorities for compiling. The lower the value, the sooner the pipeline is compiled.
   // The shader cache is compiled last, as it is the least likely to be required. On demand
   // shaders are always compiled before pending ubershaders, as we want to use the ubershader
-  // for as few frames as possible, otherwise we risk framerate drops.
+  // for as few frames as possible, otherwise we risk framerate drops. Pipelines which the game is
+  // predicted to need soon come right after the on demand ones.
   enum : u32
   {
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
+    COMPILE_PRIORITY_PREDICTED_PIPELINE = 150,
     COMPILE_PRIORITY_UBERSHADER_PIPELINE = 200,
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
   };
@@ -231,6 +246,26 @@ private:
   LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
+  // Predictive pipeline compilation. The trace lists the first use of each pipeline in previous
+  // sessions, in order. Instead of queueing all of them at startup, the pipelines are compiled a
+  // few at a time in trace order, and the ones which followed a pipeline in the trace are moved
+  // forward when the game uses it for the first time.
+  struct PipelineTraceEntry
+  {
+    GXPipelineUid uid;
+    u32 frame;
+  };
+  std::string m_pipeline_trace_filename;
+  std::vector<PipelineTraceEntry> m_pipeline_trace;
+  std::map<GXPipelineUid, size_t> m_pipeline_trace_indices;
+  std::vector<GXPipelineUid> m_predicted_pipelines;
+  size_t m_pipeline_trace_cursor = 0;
+  bool m_pipeline_trace_wrapped = false;
+  bool m_predicting_pipelines = false;
+  std::vector<SerializedGXPipelineUsage> m_session_pipeline_trace;
+  std::set<GXPipelineUid> m_session_used_pipelines;
+  u32 m_frame_number = 0;
+
   // EFB copy to VRAM/RAM pipelines
   std::map<TextureConversionShaderGen::TCShaderUid, std::unique_ptr<AbstractPipeline>>
       m_efb_copy_to_vram_pipelines;
@@ -8,6 +8,8 @@
 
 #include <imgui.h>
 
+#include "Core/Rewind.h"
+
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -70,6 +72,14 @@ void Statistics::Display() const
   draw_statistic("vshaders alive", "%d", num_vertex_shaders_alive);
   draw_statistic("shaders changes", "%d", this_frame.num_shader_changes);
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
+  if (g_ActiveConfig.bDisplayListCache)
+  {
+    const int lookups = this_frame.num_dlist_cache_hits + this_frame.num_dlist_cache_misses;
+    draw_statistic("dlist cache hits", "%d (%d%%)", this_frame.num_dlist_cache_hits,
+                   lookups ? this_frame.num_dlist_cache_hits * 100 / lookups : 0);
+    draw_statistic("dlist cache misses", "%d", this_frame.num_dlist_cache_misses);
+    draw_statistic("Primitives replayed", "%d", this_frame.num_cached_prims);
+  }
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
@@ -87,6 +97,15 @@ void Statistics::Display() const
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
 
+  if (Rewind::IsEnabled())
+  {
+    const Rewind::Statistics rewind = Rewind::GetStatistics();
+    draw_statistic("Rewind states:", "%u", rewind.num_states);
+    draw_statistic("Rewind memory:", "%u kB", static_cast<u32>(rewind.memory_usage / 1024));
+    draw_statistic("Rewind capture:", "%u us", rewind.capture_time_us);
+    draw_statistic("Rewind interval:", "%u fields", rewind.interval);
+  }
+
   ImGui::Columns(1);
 
   ImGui::End();
@@ -41,6 +41,9 @@ struct Statistics
     int num_draw_calls;
 
     int num_dlists_called;
+    int num_dlist_cache_hits;
+    int num_dlist_cache_misses;
+    int num_cached_prims;
 
     int bytes_vertex_streamed;
     int bytes_index_streamed;
@@ -68,8 +68,12 @@ TextureCacheBase::TCacheEntry::TCacheEntry(std::unique_ptr<AbstractTexture> tex,
 
 TextureCacheBase::TCacheEntry::~TCacheEntry()
 {
-  for (auto& reference : references)
-    reference->references.erase(this);
+  for (TCacheEntry* reference : references)
+  {
+    auto& other_references = reference->references;
+    other_references.erase(std::remove(other_references.begin(), other_references.end(), this),
+                           other_references.end());
+  }
 }
 
 void TextureCacheBase::CheckTempSize(size_t required_size)
@@ -92,6 +96,9 @@ TextureCacheBase::TextureCacheBase()
   TexDecoder_SetTexFmtOverlayOptions(backup_config.texfmt_overlay,
                                      backup_config.texfmt_overlay_center);
 
+  m_texture_decoder =
+      std::make_unique<VideoCommon::ParallelTextureDecoder>(backup_config.texture_decoding_threads);
+
   HiresTexture::Init();
 
   Common::SetHash64Function();
@@ -127,12 +134,13 @@ void TextureCacheBase::Invalidate()
   InvalidateAllBindPoints();
 
   bound_textures.fill(nullptr);
-  for (auto& tex : textures_by_address)
+  for (TCacheEntry* entry : textures_by_address)
   {
-    delete tex.second;
+    delete entry;
   }
   textures_by_address.clear();
   textures_by_hash.clear();
+  m_tracked_hashes.clear();
 
   texture_pool.clear();
 }
@@ -151,7 +159,8 @@ void TextureCacheBase::ForceReload()
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.iHiresTexturesCacheSize != backup_config.hires_textures_cache_size)
   {
     HiresTexture::Update();
   }
@@ -169,6 +178,13 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  if (config.GetTextureDecodingThreads() != backup_config.texture_decoding_threads)
+  {
+    m_texture_decoder.reset();
+    m_texture_decoder =
+        std::make_unique<VideoCommon::ParallelTextureDecoder>(config.GetTextureDecodingThreads());
+  }
+
   SetBackupConfig(config);
 }
 
@@ -178,25 +194,25 @@ void TextureCacheBase::Cleanup(int _frameCount)
   TexAddrCache::iterator tcend = textures_by_address.end();
   while (iter != tcend)
   {
-    if (iter->second->tmem_only)
+    if ((*iter)->tmem_only)
     {
       iter = InvalidateTexture(iter);
     }
-    else if (iter->second->frameCount == FRAMECOUNT_INVALID)
+    else if ((*iter)->frameCount == FRAMECOUNT_INVALID)
     {
-      iter->second->frameCount = _frameCount;
+      (*iter)->frameCount = _frameCount;
       ++iter;
     }
-    else if (_frameCount > TEXTURE_KILL_THRESHOLD + iter->second->frameCount)
+    else if (_frameCount > TEXTURE_KILL_THRESHOLD + (*iter)->frameCount)
     {
-      if (iter->second->IsCopy())
+      if ((*iter)->IsCopy())
       {
         // Only remove EFB copies when they wouldn't be used anymore(changed hash), because EFB
         // copies living on the
         // host GPU are unrecoverable. Perform this check only every TEXTURE_KILL_THRESHOLD for
         // performance reasons
-        if ((_frameCount - iter->second->frameCount) % TEXTURE_KILL_THRESHOLD == 1 &&
-            iter->second->hash != iter->second->CalculateHash())
+        if ((_frameCount - (*iter)->frameCount) % TEXTURE_KILL_THRESHOLD == 1 &&
+            (*iter)->hash != (*iter)->CalculateHash())
         {
           iter = InvalidateTexture(iter);
         }
@@ -246,6 +262,11 @@ bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 r
   return true;
 }
 
+bool TextureCacheBase::TCacheEntry::CustomTextureFinishedLoading() const
+{
+  return !loading_custom_tex.empty() && !HiresTexture::IsLoading(loading_custom_tex);
+}
+
 void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 {
   backup_config.color_samples = config.iSafeTextureCache_ColorSamples;
@@ -253,11 +274,13 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.hires_textures_cache_size = config.iHiresTexturesCacheSize;
   backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
   backup_config.disable_vram_copies = config.bDisableCopyToVRAM;
   backup_config.arbitrary_mipmap_detection = config.bArbitraryMipmapDetection;
+  backup_config.texture_decoding_threads = config.GetTextureDecodingThreads();
 }
 
 TextureCacheBase::TCacheEntry*
@@ -578,12 +601,12 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
   std::vector<std::pair<u64, u32>> textures_by_hash_list;
   if (Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE))
   {
-    for (const auto& it : textures_by_address)
+    for (auto it = textures_by_address.begin(); it != textures_by_address.end(); ++it)
     {
-      if (ShouldSaveEntry(it.second))
+      if (ShouldSaveEntry(*it))
       {
-        const u32 id = AddCacheEntryToMap(it.second);
-        textures_by_address_list.emplace_back(it.first, id);
+        const u32 id = AddCacheEntryToMap(*it);
+        textures_by_address_list.emplace_back(it.address(), id);
       }
     }
     for (const auto& it : textures_by_hash)
@@ -683,7 +706,6 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
     // to update the point in the state state. We'll just throw it away if it's invalid.
     auto tex = DeserializeTexture(p);
     TCacheEntry* entry = new TCacheEntry(std::move(tex->texture), std::move(tex->framebuffer));
-    entry->textures_by_hash_iter = textures_by_hash.end();
     entry->DoState(p);
     if (entry->texture && commit_state)
       id_map.emplace(i, entry);
@@ -730,7 +752,10 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     TCacheEntry* entry = GetEntry(id);
     if (entry)
-      entry->textures_by_hash_iter = textures_by_hash.emplace(hash, entry);
+    {
+      textures_by_hash.emplace(hash, entry);
+      entry->textures_by_hash_key = hash;
+    }
   }
 }
 
@@ -786,9 +811,9 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
   auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
   while (iter.first != iter.second)
   {
-    TCacheEntry* entry = iter.first->second;
+    TCacheEntry* entry = *iter.first;
     if (entry != entry_to_update && entry->IsCopy() && !entry->tmem_only &&
-        entry->references.count(entry_to_update) == 0 &&
+        !entry->HasReference(entry_to_update) &&
         entry->OverlapsMemoryRange(entry_to_update->addr, entry_to_update->size_in_bytes) &&
         entry->memory_stride == numBlocksX * block_size)
     {
@@ -1214,6 +1239,31 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   return entry;
 }
 
+u64 TextureCacheBase::GetTrackedHash(u32 address, const u8* data, u32 size)
+{
+  // Ranges are never removed individually, so start over once there are too many of them.
+  constexpr size_t MAX_TRACKED_HASHES = 16384;
+
+  const u64 key = (u64(address) << 32) | size;
+  const auto iter = m_tracked_hashes.find(key);
+  if (iter != m_tracked_hashes.end() &&
+      !Memory::WrittenSince(address, size, iter->second.write_token))
+  {
+    return iter->second.hash;
+  }
+
+  // The range has to be tracked before it is read, so that no write can fall in between.
+  const u64 write_token = Memory::TrackWrites(address, size);
+  const u64 hash = Common::GetHash64(data, size, 0);
+  if (write_token != 0)
+  {
+    if (iter == m_tracked_hashes.end() && m_tracked_hashes.size() >= MAX_TRACKED_HASHES)
+      m_tracked_hashes.clear();
+    m_tracked_hashes.insert_or_assign(key, TrackedHash{hash, write_token});
+  }
+  return hash;
+}
+
 TextureCacheBase::TCacheEntry*
 TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, TextureInfo& texture_info)
 {
@@ -1258,8 +1308,16 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  if (Memory::IsWriteTrackingEnabled() && !texture_info.IsFromTmem())
+  {
+    base_hash = GetTrackedHash(texture_info.GetRawAddress(), texture_info.GetData(),
+                               texture_info.GetTextureSize());
+  }
+  else
+  {
+    base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
+                                  textureCacheSafetyColorSampleSize);
+  }
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
@@ -1321,7 +1379,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
 
   while (iter != iter_range.second)
   {
-    TCacheEntry* entry = iter->second;
+    TCacheEntry* entry = *iter;
 
     // Skip entries that are only left in our texture cache for the tmem cache emulation
     if (entry->tmem_only)
@@ -1406,7 +1464,14 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
-        entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
+        // Replace the native texture once its custom texture is loaded.
+        if (entry->CustomTextureFinishedLoading())
+        {
+          iter = InvalidateTexture(iter);
+          continue;
+        }
+
+        entry = DoPartialTextureUpdates(*iter, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
         entry->texture->FinishedRendering();
         return entry;
@@ -1432,7 +1497,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   if (unreinterpreted_copy != textures_by_address.end())
   {
     TCacheEntry* decoded_entry =
-        ReinterpretEntry(unreinterpreted_copy->second, texture_info.GetTextureFormat());
+        ReinterpretEntry(*unreinterpreted_copy, texture_info.GetTextureFormat());
 
     // It's possible to combine reinterpreted textures + palettes.
     if (unreinterpreted_copy == unconverted_copy && decoded_entry)
@@ -1446,7 +1511,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   if (unconverted_copy != textures_by_address.end())
   {
     TCacheEntry* decoded_entry = ApplyPaletteToEntry(
-        unconverted_copy->second, texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        *unconverted_copy, texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
 
     if (decoded_entry)
     {
@@ -1464,22 +1529,20 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
   {
-    auto hash_range = textures_by_hash.equal_range(full_hash);
-    TexHashCache::iterator hash_iter = hash_range.first;
-    while (hash_iter != hash_range.second)
-    {
-      TCacheEntry* entry = hash_iter->second;
+    TCacheEntry* entry = textures_by_hash.find_if(full_hash, [&](const TCacheEntry* candidate) {
       // All parameters, except the address, need to match here
-      if (entry->format == full_format && entry->native_levels >= texture_info.GetLevelCount() &&
-          entry->native_width == texture_info.GetRawWidth() &&
-          entry->native_height == texture_info.GetRawHeight())
-      {
-        entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
-                                        texture_info.GetTlutFormat());
-        entry->texture->FinishedRendering();
-        return entry;
-      }
-      ++hash_iter;
+      return candidate->format == full_format &&
+             candidate->native_levels >= texture_info.GetLevelCount() &&
+             candidate->native_width == texture_info.GetRawWidth() &&
+             candidate->native_height == texture_info.GetRawHeight() &&
+             !candidate->CustomTextureFinishedLoading();
+    });
+    if (entry)
+    {
+      entry = DoPartialTextureUpdates(entry, texture_info.GetTlutAddress(),
+                                      texture_info.GetTlutFormat());
+      entry->texture->FinishedRendering();
+      return entry;
     }
   }
 
@@ -1491,9 +1554,11 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
+  std::string loading_hires_tex;
   if (g_ActiveConfig.bHiresTextures)
   {
-    hires_tex = HiresTexture::Search(texture_info);
+    // While the custom texture is loading, the native texture is used.
+    hires_tex = HiresTexture::Search(texture_info, &loading_hires_tex);
 
     if (hires_tex)
     {
@@ -1538,6 +1603,10 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   // Initialized to null because only software loading uses this buffer
   u8* dst_buffer = nullptr;
 
+  // Set when the mipmaps were queued on the texture decoder along with the first level.
+  bool mipmaps_queued = false;
+  u32 next_decoder_level = 0;
+
   if (!hires_tex)
   {
     if (!decode_on_gpu ||
@@ -1569,9 +1638,31 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
       dst_buffer = temp;
       if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        m_texture_decoder->QueueLevel(dst_buffer, texture_info.GetData(), expanded_width,
+                                      expanded_height, texture_info.GetTextureFormat(),
+                                      texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+
+        // Without GPU decoding, all mipmaps are decoded on the CPU. Queue them right away, so that
+        // they are decoded while the levels before them are uploaded.
+        if (!decode_on_gpu)
+        {
+          u8* mip_dst = dst_buffer + decoded_texture_size;
+          for (u32 level = 1; level != texLevels; ++level)
+          {
+            auto mip_level = texture_info.GetMipMapLevel(level - 1);
+            if (!mip_level)
+              continue;
+
+            m_texture_decoder->QueueLevel(
+                mip_dst, mip_level->GetData(), mip_level->GetExpandedWidth(),
+                mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
+                texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+            mip_dst += mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
+          }
+          mipmaps_queued = true;
+        }
+
+        m_texture_decoder->WaitForLevel(next_decoder_level++);
       }
       else
       {
@@ -1593,7 +1684,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
   {
-    entry->textures_by_hash_iter = textures_by_hash.emplace(full_hash, entry);
+    textures_by_hash.emplace(full_hash, entry);
+    entry->textures_by_hash_key = full_hash;
   }
 
   entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
@@ -1602,11 +1694,15 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
                        texture_info.GetLevelCount());
   entry->SetHashes(base_hash, full_hash);
   entry->is_custom_tex = hires_tex != nullptr;
+  entry->loading_custom_tex = std::move(loading_hires_tex);
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
+  // Textures which are replaced by a custom texture once it has been loaded aren't dumped either.
+  const bool dump_texture =
+      g_ActiveConfig.bDumpTextures && !hires_tex && entry->loading_custom_tex.empty();
   std::string basename;
-  if (g_ActiveConfig.bDumpTextures && !hires_tex)
+  if (dump_texture)
   {
     basename = HiresTexture::GenBaseName(texture_info, true);
   }
@@ -1639,9 +1735,14 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        if (!mipmaps_queued)
+        {
+          m_texture_decoder->QueueLevel(
+              dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
+              mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
+              texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        }
+        m_texture_decoder->WaitForLevel(next_decoder_level++);
         entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
 
@@ -1651,12 +1752,14 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
         dst_buffer += decoded_mip_size;
       }
     }
+
+    m_texture_decoder->Finish();
   }
 
   entry->has_arbitrary_mips = hires_tex ? hires_tex->HasArbitraryMipmaps() :
                                           arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
 
-  if (g_ActiveConfig.bDumpTextures && !hires_tex)
+  if (dump_texture)
   {
     for (u32 level = 0; level < texLevels; ++level)
     {
@@ -1667,7 +1770,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   INCSTAT(g_stats.num_textures_uploaded);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
 
-  entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
+  entry = DoPartialTextureUpdates(*iter, texture_info.GetTlutAddress(),
                                   texture_info.GetTlutFormat());
 
   // This should only be needed if the texture was updated, or used GPU decoding.
@@ -1766,7 +1869,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetXFBFromCache(u32 address, u3
 
   while (iter != iter_range.second)
   {
-    TCacheEntry* entry = iter->second;
+    TCacheEntry* entry = *iter;
 
     // The only thing which has to match exactly is the stride. We can use a partial rectangle if
     // the VI width/height differs from that of the XFB copy.
@@ -1812,7 +1915,7 @@ void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
     // our force progressive hack means that an XFB copy should always have a matching stride. If
     // the hack is disabled, XFB2RAM should also be enabled. Should we wish to implement interlaced
     // stitching in the future, this would require a shader which grabs every second line.
-    TCacheEntry* entry = iter.first->second;
+    TCacheEntry* entry = *iter.first;
     if (entry != stitched_entry && entry->IsCopy() && !entry->tmem_only &&
         entry->OverlapsMemoryRange(stitched_entry->addr, stitched_entry->size_in_bytes) &&
         entry->memory_stride == stitched_entry->memory_stride)
@@ -2227,7 +2330,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   auto iter = FindOverlappingTextures(dstAddr, covered_range);
   while (iter.first != iter.second)
   {
-    TCacheEntry* overlapping_entry = iter.first->second;
+    TCacheEntry* overlapping_entry = *iter.first;
 
     if (overlapping_entry->addr == dstAddr && overlapping_entry->is_xfb_copy)
     {
@@ -2273,10 +2376,10 @@ void TextureCacheBase::CopyRenderTargetToTexture(
 
       // Do not load textures by hash, if they were at least partly overwritten by an efb copy.
       // In this case, comparing the hash is not enough to check, if two textures are identical.
-      if (overlapping_entry->textures_by_hash_iter != textures_by_hash.end())
+      if (overlapping_entry->textures_by_hash_key)
       {
-        textures_by_hash.erase(overlapping_entry->textures_by_hash_iter);
-        overlapping_entry->textures_by_hash_iter = textures_by_hash.end();
+        textures_by_hash.erase(*overlapping_entry->textures_by_hash_key, overlapping_entry);
+        overlapping_entry->textures_by_hash_key.reset();
       }
     }
     ++iter.first;
@@ -2351,7 +2454,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
     auto range = FindOverlappingTextures(entry->addr, covered_range);
     for (auto iter = range.first; iter != range.second; ++iter)
     {
-      TCacheEntry* overlapping_entry = iter->second;
+      TCacheEntry* overlapping_entry = *iter;
       if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy &&
           overlapping_entry->OverlapsMemoryRange(entry->addr, covered_range))
       {
@@ -2435,7 +2538,6 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::AllocateCacheEntry(const Textur
 
   TCacheEntry* cacheEntry =
       new TCacheEntry(std::move(alloc->texture), std::move(alloc->framebuffer));
-  cacheEntry->textures_by_hash_iter = textures_by_hash.end();
   cacheEntry->id = last_entry_id++;
   return cacheEntry;
 }
@@ -2497,7 +2599,7 @@ TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
   TexAddrCache::iterator iter = iter_range.first;
   while (iter != iter_range.second)
   {
-    if (iter->second == entry)
+    if (*iter == entry)
     {
       return iter;
     }
@@ -2529,12 +2631,12 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
   if (iter == textures_by_address.end())
     return textures_by_address.end();
 
-  TCacheEntry* entry = iter->second;
+  TCacheEntry* entry = *iter;
 
-  if (entry->textures_by_hash_iter != textures_by_hash.end())
+  if (entry->textures_by_hash_key)
   {
-    textures_by_hash.erase(entry->textures_by_hash_iter);
-    entry->textures_by_hash_iter = textures_by_hash.end();
+    textures_by_hash.erase(*entry->textures_by_hash_key, entry);
+    entry->textures_by_hash_key.reset();
   }
 
   for (size_t i = 0; i < bound_textures.size(); ++i)
@@ -4,21 +4,22 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <bitset>
-#include <map>
 #include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/ParallelTextureDecoder.h"
+#include "VideoCommon/TextureCacheIndex.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureInfo.h"
@@ -98,6 +99,8 @@ public:
     u32 memory_stride;
     bool is_efb_copy;
     bool is_custom_tex;
+    // The custom texture which was still being loaded when this entry was created, if any.
+    std::string loading_custom_tex;
     bool may_have_overlapping_textures = true;
     bool tmem_only = false;           // indicates that this texture only exists in the tmem cache
     bool has_arbitrary_mips = false;  // indicates that the mips in this texture are arbitrary
@@ -116,14 +119,14 @@ public:
     // used to delete textures which haven't been used for TEXTURE_KILL_THRESHOLD frames
     int frameCount = FRAMECOUNT_INVALID;
 
-    // Keep an iterator to the entry in textures_by_hash, so it does not need to be searched when
-    // removing the cache entry
-    std::multimap<u64, TCacheEntry*>::iterator textures_by_hash_iter;
+    // The hash this entry was inserted into textures_by_hash with, if it can be looked up by hash
+    std::optional<u64> textures_by_hash_key;
 
     // This is used to keep track of both:
     //   * efb copies used by this partially updated texture
     //   * partially updated textures which refer to this efb copy
-    std::unordered_set<TCacheEntry*> references;
+    // There are rarely more than a few of them, so a vector is cheaper than a set.
+    std::vector<TCacheEntry*> references;
 
     // Pending EFB copy
     std::unique_ptr<AbstractStagingTexture> pending_efb_copy;
@@ -164,8 +167,15 @@ public:
     void CreateReference(TCacheEntry* other_entry)
     {
       // References are two-way, so they can easily be destroyed later
-      this->references.emplace(other_entry);
-      other_entry->references.emplace(this);
+      if (HasReference(other_entry))
+        return;
+      this->references.push_back(other_entry);
+      other_entry->references.push_back(this);
+    }
+
+    bool HasReference(const TCacheEntry* other_entry) const
+    {
+      return std::find(references.begin(), references.end(), other_entry) != references.end();
     }
 
     void SetXfbCopy(u32 stride);
@@ -174,6 +184,9 @@ public:
 
     bool OverlapsMemoryRange(u32 range_address, u32 range_size) const;
 
+    // Whether loading the custom texture has finished since, so the entry should be recreated.
+    bool CustomTextureFinishedLoading() const;
+
     bool IsEfbCopy() const { return is_efb_copy; }
     bool IsCopy() const { return is_xfb_copy || is_efb_copy; }
     u32 NumBlocksY() const;
@@ -273,8 +286,8 @@ protected:
   static std::bitset<8> valid_bind_points;
 
 private:
-  using TexAddrCache = std::multimap<u32, TCacheEntry*>;
-  using TexHashCache = std::multimap<u64, TCacheEntry*>;
+  using TexAddrCache = TextureAddressIndex<TCacheEntry*>;
+  using TexHashCache = TextureHashIndex<TCacheEntry*>;
   using TexPool = std::unordered_multimap<TextureConfig, TexPoolEntry>;
 
   bool CreateUtilityTextures();
@@ -283,6 +296,10 @@ private:
 
   TCacheEntry* GetXFBFromCache(u32 address, u32 width, u32 height, u32 stride);
 
+  // Hashes all of the given texture data in RAM, or returns the previous hash of the same range if
+  // write tracking shows that none of its pages have been written to since.
+  u64 GetTrackedHash(u32 address, const u8* data, u32 size);
+
   TCacheEntry* ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLUTFormat tlutfmt);
 
   TCacheEntry* ReinterpretEntry(const TCacheEntry* existing_entry, TextureFormat new_format);
@@ -336,6 +353,14 @@ private:
   TexPool texture_pool;
   u64 last_entry_id = 0;
 
+  struct TrackedHash
+  {
+    u64 hash;
+    u64 write_token;
+  };
+  // Keyed by address and size.
+  std::unordered_map<u64, TrackedHash> m_tracked_hashes;
+
   // Backup configuration values
   struct BackupConfig
   {
@@ -344,12 +369,14 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    int hires_textures_cache_size;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
     bool gpu_texture_decoding;
     bool disable_vram_copies;
     bool arbitrary_mipmap_detection;
+    u32 texture_decoding_threads;
   };
   BackupConfig backup_config = {};
 
@@ -360,6 +387,10 @@ private:
   // Decoding texture used for GPU texture decoding.
   std::unique_ptr<AbstractTexture> m_decoding_texture;
 
+  // Decodes textures on the CPU, decoding the mipmaps of a texture while its first level is
+  // uploaded.
+  std::unique_ptr<VideoCommon::ParallelTextureDecoder> m_texture_decoder;
+
   // Pool of readback textures used for deferred EFB copies.
   std::vector<std::unique_ptr<AbstractStagingTexture>> m_efb_copy_staging_texture_pool;
 
@@ -0,0 +1,387 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
+
+// Maps guest addresses to values, allowing several values per address. The values are kept in a
+// single list sorted by address, much like a std::multimap, but the nodes of that list are pooled
+// in one array and every page of guest memory remembers where its first value is, so looking up an
+// address only has to walk the values on its page instead of chasing pointers down a tree.
+//
+// Inserting or erasing values doesn't invalidate iterators to other values, and values inserted at
+// the same address are kept in insertion order.
+template <typename T>
+class TextureAddressIndex
+{
+  static constexpr u32 INVALID_NODE = UINT32_MAX;
+  static constexpr u32 PAGE_SHIFT = 12;
+  // Texture and copy addresses are at most 29 bits wide. Anything above shares the last page.
+  static constexpr u32 NUM_PAGES = 1 << (29 - PAGE_SHIFT);
+
+  struct Node
+  {
+    u32 address;
+    u32 prev;
+    u32 next;
+    T value;
+  };
+
+public:
+  class iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    iterator() = default;
+
+    T& operator*() const { return m_index->m_nodes[m_node].value; }
+    T* operator->() const { return &m_index->m_nodes[m_node].value; }
+    u32 address() const { return m_index->m_nodes[m_node].address; }
+
+    iterator& operator++()
+    {
+      m_node = m_index->m_nodes[m_node].next;
+      return *this;
+    }
+    iterator operator++(int)
+    {
+      iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const iterator& other) const { return m_node == other.m_node; }
+    bool operator!=(const iterator& other) const { return m_node != other.m_node; }
+
+  private:
+    friend class TextureAddressIndex;
+
+    iterator(TextureAddressIndex* index, u32 node) : m_index(index), m_node(node) {}
+
+    TextureAddressIndex* m_index = nullptr;
+    u32 m_node = INVALID_NODE;
+  };
+
+  iterator begin() { return {this, m_first_node}; }
+  iterator end() { return {this, INVALID_NODE}; }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  // Returns the first value at or after address.
+  iterator lower_bound(u32 address) { return {this, FindFirstNode(address, false)}; }
+
+  // Returns the first value after address.
+  iterator upper_bound(u32 address) { return {this, FindFirstNode(address, true)}; }
+
+  std::pair<iterator, iterator> equal_range(u32 address)
+  {
+    const iterator first = lower_bound(address);
+    iterator last = first;
+    while (last != end() && last.address() == address)
+      ++last;
+    return {first, last};
+  }
+
+  // Inserts the value after all other values at the same address.
+  iterator emplace(u32 address, T value)
+  {
+    const u32 next = FindFirstNode(address, true);
+    const u32 prev = next != INVALID_NODE ? m_nodes[next].prev : m_last_node;
+
+    u32 node;
+    if (m_free_node != INVALID_NODE)
+    {
+      node = m_free_node;
+      m_free_node = m_nodes[node].next;
+      m_nodes[node] = {address, prev, next, std::move(value)};
+    }
+    else
+    {
+      node = static_cast<u32>(m_nodes.size());
+      m_nodes.push_back({address, prev, next, std::move(value)});
+    }
+
+    if (prev != INVALID_NODE)
+      m_nodes[prev].next = node;
+    else
+      m_first_node = node;
+    if (next != INVALID_NODE)
+      m_nodes[next].prev = node;
+    else
+      m_last_node = node;
+
+    const u32 page = GetPage(address);
+    if (page >= m_page_heads.size())
+    {
+      m_page_heads.resize(page + 1, INVALID_NODE);
+      m_occupied_pages.resize(page / 64 + 1);
+    }
+    if (prev == INVALID_NODE || GetPage(m_nodes[prev].address) != page)
+    {
+      m_page_heads[page] = node;
+      m_occupied_pages[page / 64] |= u64(1) << (page % 64);
+    }
+
+    m_size++;
+    return {this, node};
+  }
+
+  // Removes the value and returns an iterator to the one after it.
+  iterator erase(iterator it)
+  {
+    const u32 node = it.m_node;
+    const u32 prev = m_nodes[node].prev;
+    const u32 next = m_nodes[node].next;
+
+    const u32 page = GetPage(m_nodes[node].address);
+    if (m_page_heads[page] == node)
+    {
+      if (next != INVALID_NODE && GetPage(m_nodes[next].address) == page)
+      {
+        m_page_heads[page] = next;
+      }
+      else
+      {
+        m_page_heads[page] = INVALID_NODE;
+        m_occupied_pages[page / 64] &= ~(u64(1) << (page % 64));
+      }
+    }
+
+    if (prev != INVALID_NODE)
+      m_nodes[prev].next = next;
+    else
+      m_first_node = next;
+    if (next != INVALID_NODE)
+      m_nodes[next].prev = prev;
+    else
+      m_last_node = prev;
+
+    m_nodes[node].value = T{};
+    m_nodes[node].next = m_free_node;
+    m_free_node = node;
+
+    m_size--;
+    return {this, next};
+  }
+
+  void clear()
+  {
+    m_nodes.clear();
+    m_page_heads.clear();
+    m_occupied_pages.clear();
+    m_first_node = INVALID_NODE;
+    m_last_node = INVALID_NODE;
+    m_free_node = INVALID_NODE;
+    m_size = 0;
+  }
+
+private:
+  static u32 GetPage(u32 address) { return std::min(address >> PAGE_SHIFT, NUM_PAGES - 1); }
+
+  // Returns the first page at or after page which holds any values.
+  u32 FindOccupiedPage(u32 page) const
+  {
+    size_t word = page / 64;
+    if (word >= m_occupied_pages.size())
+      return INVALID_NODE;
+
+    u64 bits = m_occupied_pages[word] & (~u64(0) << (page % 64));
+    while (bits == 0)
+    {
+      if (++word == m_occupied_pages.size())
+        return INVALID_NODE;
+      bits = m_occupied_pages[word];
+    }
+    return static_cast<u32>(word * 64 + Common::LeastSignificantSetBit(bits));
+  }
+
+  u32 FindFirstNode(u32 address, bool after_address) const
+  {
+    const u32 page = FindOccupiedPage(GetPage(address));
+    if (page == INVALID_NODE)
+      return INVALID_NODE;
+
+    // As the list is sorted, values which are not on the page of the address come after it.
+    u32 node = m_page_heads[page];
+    while (node != INVALID_NODE && (m_nodes[node].address < address ||
+                                    (after_address && m_nodes[node].address == address)))
+    {
+      node = m_nodes[node].next;
+    }
+    return node;
+  }
+
+  std::vector<Node> m_nodes;
+  std::vector<u32> m_page_heads;
+  std::vector<u64> m_occupied_pages;
+  u32 m_first_node = INVALID_NODE;
+  u32 m_last_node = INVALID_NODE;
+  u32 m_free_node = INVALID_NODE;
+  size_t m_size = 0;
+};
+
+// Maps hashes of texture contents to values, allowing several values per hash. The values are
+// stored inline in an open-addressing table with linear probing, so a lookup usually touches a
+// single cache line. A default-constructed T marks an empty slot and can't be stored.
+template <typename T>
+class TextureHashIndex
+{
+  using Slot = std::pair<u64, T>;
+
+public:
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Slot;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Slot*;
+    using reference = const Slot&;
+
+    const Slot& operator*() const { return *m_slot; }
+    const Slot* operator->() const { return m_slot; }
+
+    const_iterator& operator++()
+    {
+      ++m_slot;
+      SkipEmptySlots();
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const { return m_slot == other.m_slot; }
+    bool operator!=(const const_iterator& other) const { return m_slot != other.m_slot; }
+
+  private:
+    friend class TextureHashIndex;
+
+    const_iterator(const Slot* slot, const Slot* end) : m_slot(slot), m_end(end)
+    {
+      SkipEmptySlots();
+    }
+
+    void SkipEmptySlots()
+    {
+      while (m_slot != m_end && m_slot->second == T{})
+        ++m_slot;
+    }
+
+    const Slot* m_slot;
+    const Slot* m_end;
+  };
+
+  const_iterator begin() const
+  {
+    return {m_slots.data(), m_slots.data() + m_slots.size()};
+  }
+  const_iterator end() const
+  {
+    return {m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()};
+  }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  void emplace(u64 hash, T value)
+  {
+    if ((m_size + 1) * 2 > m_slots.size())
+      Rehash(std::max<size_t>(m_slots.size() * 2, 64));
+
+    const size_t mask = m_slots.size() - 1;
+    size_t i = GetHomeSlot(hash, mask);
+    while (m_slots[i].second != T{})
+      i = (i + 1) & mask;
+    m_slots[i] = {hash, std::move(value)};
+    m_size++;
+  }
+
+  // Returns whether the value was stored for the hash.
+  bool erase(u64 hash, const T& value)
+  {
+    if (m_size == 0)
+      return false;
+
+    const size_t mask = m_slots.size() - 1;
+    size_t hole = GetHomeSlot(hash, mask);
+    while (m_slots[hole].first != hash || m_slots[hole].second != value)
+    {
+      if (m_slots[hole].second == T{})
+        return false;
+      hole = (hole + 1) & mask;
+    }
+
+    // Move later slots of the same cluster back into the hole if that doesn't put them in front
+    // of their home slot, so lookups never have to skip over deleted slots.
+    for (size_t i = (hole + 1) & mask; m_slots[i].second != T{}; i = (i + 1) & mask)
+    {
+      const size_t home = GetHomeSlot(m_slots[i].first, mask);
+      if (((i - home) & mask) >= ((i - hole) & mask))
+      {
+        m_slots[hole] = std::move(m_slots[i]);
+        hole = i;
+      }
+    }
+    m_slots[hole] = {};
+    m_size--;
+    return true;
+  }
+
+  // Returns the first value stored for the hash which satisfies the predicate, or T{} if there is
+  // none.
+  template <typename Predicate>
+  T find_if(u64 hash, Predicate predicate) const
+  {
+    if (m_size == 0)
+      return T{};
+
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = GetHomeSlot(hash, mask); m_slots[i].second != T{}; i = (i + 1) & mask)
+    {
+      if (m_slots[i].first == hash && predicate(m_slots[i].second))
+        return m_slots[i].second;
+    }
+    return T{};
+  }
+
+  void clear()
+  {
+    m_slots.clear();
+    m_size = 0;
+  }
+
+private:
+  static size_t GetHomeSlot(u64 hash, size_t mask)
+  {
+    // The hashes are usually well distributed already, but some are XORed with palette hashes.
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+  }
+
+  void Rehash(size_t new_size)
+  {
+    std::vector<Slot> old_slots(new_size);
+    std::swap(m_slots, old_slots);
+    m_size = 0;
+    for (Slot& slot : old_slots)
+    {
+      if (slot.second != T{})
+        emplace(slot.first, std::move(slot.second));
+    }
+  }
+
+  std::vector<Slot> m_slots;
+  size_t m_size = 0;
+};
@@ -774,6 +774,51 @@ static void TexDecoder_DecodeImpl_RGB565(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB565_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Same swizzle as the SSE2 version, but for two rows of a block at once.
+  // The shuffle duplicates each 16-bit color into both halves of its 32-bit word.
+  const __m256i kDuplicate = _mm256_setr_epi8(0, 1, 0, 1, 2, 3, 2, 3, 4, 5, 4, 5, 6, 7, 6, 7, 8, 9,
+                                              8, 9, 10, 11, 10, 11, 12, 13, 12, 13, 14, 15, 14, 15);
+  const __m256i kMaskR0 = _mm256_set1_epi32(0x000000F8);
+  const __m256i kMaskG0 = _mm256_set1_epi32(0x0000FC00);
+  const __m256i kMaskG1 = _mm256_set1_epi32(0x00000300);
+  const __m256i kMaskB0 = _mm256_set1_epi32(0x00F80000);
+  const __m256i kAlpha = _mm256_set1_epi32(0xFF000000);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m256i c0 = _mm256_shuffle_epi8(
+            _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(src + 8 * xStep))),
+            kDuplicate);
+
+        const __m256i r0 = _mm256_and_si256(c0, kMaskR0);
+        const __m256i r1 = _mm256_srli_epi32(r0, 5);
+        const __m256i gtmp = _mm256_srli_epi32(c0, 3);
+        const __m256i g0 = _mm256_and_si256(gtmp, kMaskG0);
+        const __m256i g1 = _mm256_and_si256(_mm256_srli_epi32(gtmp, 6), kMaskG1);
+        const __m256i b0 = _mm256_and_si256(_mm256_srli_epi32(c0, 5), kMaskB0);
+        const __m256i b1 = _mm256_srli_epi16(b0, 5);
+
+        const __m256i abgr888x8 =
+            _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(r0, r1), _mm256_or_si256(g0, g1)),
+                            _mm256_or_si256(_mm256_or_si256(b0, b1), kAlpha));
+
+        _mm_storeu_si128((__m128i*)(dst + (y + iy) * width + x),
+                         _mm256_castsi256_si128(abgr888x8));
+        _mm_storeu_si128((__m128i*)(dst + (y + iy + 1) * width + x),
+                         _mm256_extracti128_si256(abgr888x8, 1));
+      }
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_RGB5A3_SSSE3(u32* dst, const u8* src, int width, int height,
                                                TextureFormat texformat, const u8* tlut,
@@ -881,6 +926,72 @@ static void TexDecoder_DecodeImpl_RGB5A3_SSSE3(u32* dst, const u8* src, int widt
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB5A3_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Byte swaps two rows of 16-bit colors and zero extends them to 32 bits.
+  const __m256i mask =
+      _mm256_setr_epi8(1, 0, -128, -128, 3, 2, -128, -128, 5, 4, -128, -128, 7, 6, -128, -128, 9,
+                       8, -128, -128, 11, 10, -128, -128, 13, 12, -128, -128, 15, 14, -128, -128);
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x0000001fL);
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0000000fL);
+  const __m256i kMask_x07 = _mm256_set1_epi32(0x00000007L);
+  const __m256i kMask_x8000 = _mm256_set1_epi32(0x00008000L);
+  const __m256i aVxff00 = _mm256_set1_epi32(0xFF000000L);
+
+  // Unlike the SSSE3 version, both encodings are always decoded and the right one is selected per
+  // pixel, so textures which mix them don't fall back to scalar code.
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m256i valV = _mm256_shuffle_epi8(
+            _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(src + 8 * xStep))), mask);
+
+        // RGB555, swizzle bits: 00012345 -> 12345123
+        const __m256i tmpr5V = _mm256_and_si256(_mm256_srli_epi32(valV, 10), kMask_x1f);
+        const __m256i r5V =
+            _mm256_or_si256(_mm256_slli_epi32(tmpr5V, 3), _mm256_srli_epi32(tmpr5V, 2));
+        const __m256i tmpg5V = _mm256_and_si256(_mm256_srli_epi32(valV, 5), kMask_x1f);
+        const __m256i g5V =
+            _mm256_or_si256(_mm256_slli_epi32(tmpg5V, 3), _mm256_srli_epi32(tmpg5V, 2));
+        const __m256i tmpb5V = _mm256_and_si256(valV, kMask_x1f);
+        const __m256i b5V =
+            _mm256_or_si256(_mm256_slli_epi32(tmpb5V, 3), _mm256_srli_epi32(tmpb5V, 2));
+        const __m256i rgb555 =
+            _mm256_or_si256(_mm256_or_si256(r5V, _mm256_slli_epi32(g5V, 8)),
+                            _mm256_or_si256(_mm256_slli_epi32(b5V, 16), aVxff00));
+
+        // RGBA4443, swizzle bits: 00001234 -> 12341234
+        const __m256i tmpr4V = _mm256_and_si256(_mm256_srli_epi32(valV, 8), kMask_x0f);
+        const __m256i r4V = _mm256_or_si256(_mm256_slli_epi32(tmpr4V, 4), tmpr4V);
+        const __m256i tmpg4V = _mm256_and_si256(_mm256_srli_epi32(valV, 4), kMask_x0f);
+        const __m256i g4V = _mm256_or_si256(_mm256_slli_epi32(tmpg4V, 4), tmpg4V);
+        const __m256i tmpb4V = _mm256_and_si256(valV, kMask_x0f);
+        const __m256i b4V = _mm256_or_si256(_mm256_slli_epi32(tmpb4V, 4), tmpb4V);
+        const __m256i tmpaV = _mm256_and_si256(_mm256_srli_epi32(valV, 12), kMask_x07);
+        const __m256i aV = _mm256_or_si256(
+            _mm256_slli_epi32(tmpaV, 5),
+            _mm256_or_si256(_mm256_slli_epi32(tmpaV, 2), _mm256_srli_epi32(tmpaV, 1)));
+        const __m256i rgba4443 =
+            _mm256_or_si256(_mm256_or_si256(r4V, _mm256_slli_epi32(g4V, 8)),
+                            _mm256_or_si256(_mm256_slli_epi32(b4V, 16), _mm256_slli_epi32(aV, 24)));
+
+        const __m256i is_rgb555 =
+            _mm256_cmpeq_epi32(_mm256_and_si256(valV, kMask_x8000), kMask_x8000);
+        const __m256i final = _mm256_blendv_epi8(rgba4443, rgb555, is_rgb555);
+        _mm_storeu_si128((__m128i*)(dst + (y + iy) * width + x), _mm256_castsi256_si128(final));
+        _mm_storeu_si128((__m128i*)(dst + (y + iy + 1) * width + x),
+                         _mm256_extracti128_si256(final, 1));
+      }
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_RGB5A3(u32* dst, const u8* src, int width, int height,
                                          TextureFormat texformat, const u8* tlut,
                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
@@ -1413,6 +1524,107 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
   }
 }
 
+// Computes the third and fourth color of DXT blocks, for one channel of the first and second color
+// of each block in consecutive 32-bit words.
+FUNCTION_TARGET_AVX2
+static inline __m256i InterpolateDXTColors_AVX2(__m256i colors, __m256i blend)
+{
+  const __m256i swapped = _mm256_shuffle_epi32(colors, _MM_SHUFFLE(2, 3, 0, 1));
+  const __m256i sum = _mm256_add_epi32(colors, swapped);
+  // (colors * 5 + swapped * 3) >> 3, which is DXTBlend(color2, color1) in the even words and
+  // DXTBlend(color1, color2) in the odd words.
+  const __m256i blended = _mm256_srli_epi32(
+      _mm256_add_epi32(_mm256_add_epi32(sum, _mm256_slli_epi32(sum, 1)),
+                       _mm256_slli_epi32(colors, 1)),
+      3);
+  const __m256i average = _mm256_srli_epi32(sum, 1);
+  return _mm256_blendv_epi8(average, blended, blend);
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_CMPR_AVX2(u32* dst, const u8* src, int width, int height,
+                                            TextureFormat texformat, const u8* tlut,
+                                            TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Decodes all four DXT blocks of an 8x8 tile at once. The palettes of the blocks are computed
+  // side by side, and every row of the tile is looked up from them with a single permute instead
+  // of the scalar lookups of the SSE2 version.
+
+  // Byte swaps the two 16-bit colors of each block and zero extends them to 32 bits. The low half
+  // of the register gets the colors of the first two blocks, the high half those of the last two.
+  const __m256i color_mask = _mm256_setr_epi8(
+      1, 0, -128, -128, 3, 2, -128, -128, 9, 8, -128, -128, 11, 10, -128, -128, 1, 0, -128, -128,
+      3, 2, -128, -128, 9, 8, -128, -128, 11, 10, -128, -128);
+  // The words holding the 2-bit indices of the left and right block of the upper and lower half.
+  const __m256i upper_lines = _mm256_setr_epi32(1, 1, 1, 1, 3, 3, 3, 3);
+  const __m256i lower_lines = _mm256_setr_epi32(5, 5, 5, 5, 7, 7, 7, 7);
+  const __m256i index_shifts = _mm256_setr_epi32(6, 4, 2, 0, 6, 4, 2, 0);
+  const __m256i palette_offsets = _mm256_setr_epi32(0, 0, 0, 0, 4, 4, 4, 4);
+  const __m256i even_words = _mm256_setr_epi32(-1, 0, -1, 0, -1, 0, -1, 0);
+  const __m256i kMask_x03 = _mm256_set1_epi32(0x03);
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x1f);
+  const __m256i kMask_x3f = _mm256_set1_epi32(0x3f);
+  const __m256i kAlpha = _mm256_set1_epi32(0xFF000000);
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      const __m256i dxt =
+          _mm256_loadu_si256((const __m256i*)(src + sizeof(struct DXTBlock) * 4 * yStep));
+
+      // Expand the RGB565 colors to 8 bits per channel.
+      const __m256i c565 = _mm256_shuffle_epi8(dxt, color_mask);
+      const __m256i r5 = _mm256_srli_epi32(c565, 11);
+      const __m256i g6 = _mm256_and_si256(_mm256_srli_epi32(c565, 5), kMask_x3f);
+      const __m256i b5 = _mm256_and_si256(c565, kMask_x1f);
+      const __m256i r = _mm256_or_si256(_mm256_slli_epi32(r5, 3), _mm256_srli_epi32(r5, 2));
+      const __m256i g = _mm256_or_si256(_mm256_slli_epi32(g6, 2), _mm256_srli_epi32(g6, 4));
+      const __m256i b = _mm256_or_si256(_mm256_slli_epi32(b5, 3), _mm256_srli_epi32(b5, 2));
+
+      // Blocks whose first color is greater than the second interpolate between both colors.
+      // Otherwise, the third color is their average and the fourth the same but transparent.
+      const __m256i greater =
+          _mm256_cmpgt_epi32(c565, _mm256_shuffle_epi32(c565, _MM_SHUFFLE(2, 3, 0, 1)));
+      const __m256i blend = _mm256_shuffle_epi32(greater, _MM_SHUFFLE(2, 2, 0, 0));
+
+      const __m256i colors01 =
+          _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                          _mm256_or_si256(_mm256_slli_epi32(b, 16), kAlpha));
+      const __m256i colors23 = _mm256_or_si256(
+          _mm256_or_si256(InterpolateDXTColors_AVX2(r, blend),
+                          _mm256_slli_epi32(InterpolateDXTColors_AVX2(g, blend), 8)),
+          _mm256_or_si256(_mm256_slli_epi32(InterpolateDXTColors_AVX2(b, blend), 16),
+                          _mm256_and_si256(_mm256_or_si256(blend, even_words), kAlpha)));
+
+      // The palettes of the left and right block, for the upper and the lower half of the tile.
+      const __m256i palettes02 = _mm256_unpacklo_epi64(colors01, colors23);
+      const __m256i palettes13 = _mm256_unpackhi_epi64(colors01, colors23);
+      const __m256i upper_palettes = _mm256_permute2x128_si256(palettes02, palettes13, 0x20);
+      const __m256i lower_palettes = _mm256_permute2x128_si256(palettes02, palettes13, 0x31);
+
+      __m256i upper_indices = _mm256_permutevar8x32_epi32(dxt, upper_lines);
+      __m256i lower_indices = _mm256_permutevar8x32_epi32(dxt, lower_lines);
+      u32* dst32 = dst + y * width + x;
+      for (int iy = 0; iy < 4; iy++)
+      {
+        const __m256i upper = _mm256_or_si256(
+            _mm256_and_si256(_mm256_srlv_epi32(upper_indices, index_shifts), kMask_x03),
+            palette_offsets);
+        const __m256i lower = _mm256_or_si256(
+            _mm256_and_si256(_mm256_srlv_epi32(lower_indices, index_shifts), kMask_x03),
+            palette_offsets);
+        _mm256_storeu_si256((__m256i*)(dst32 + iy * width),
+                            _mm256_permutevar8x32_epi32(upper_palettes, upper));
+        _mm256_storeu_si256((__m256i*)(dst32 + (iy + 4) * width),
+                            _mm256_permutevar8x32_epi32(lower_palettes, lower));
+        upper_indices = _mm256_srli_epi32(upper_indices, 8);
+        lower_indices = _mm256_srli_epi32(lower_indices, 8);
+      }
+    }
+  }
+}
+
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
                             const u8* tlut, TLUTFormat tlutfmt)
 {
@@ -1464,12 +1676,19 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGB565:
-    TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                 Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB565_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else
+      TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                   Wsteps8);
     break;
 
   case TextureFormat::RGB5A3:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB5A3_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGB5A3_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                          Wsteps8);
     else
@@ -1487,7 +1706,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::CMPR:
-    TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_CMPR_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                      Wsteps8);
+    else
+      TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                 Wsteps8);
     break;
 
   case TextureFormat::XFB:
@@ -5,6 +5,7 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -240,7 +241,59 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
   return loader;
 }
 
-int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess)
+static bool UsesVertexArrays(const TVtxDesc& vtx_desc)
+{
+  if (IsIndexed(vtx_desc.low.Position) || IsIndexed(vtx_desc.low.Normal))
+    return true;
+  for (size_t i = 0; i < vtx_desc.low.Color.Size(); i++)
+  {
+    if (IsIndexed(vtx_desc.low.Color[i]))
+      return true;
+  }
+  for (size_t i = 0; i < vtx_desc.high.TexCoord.Size(); i++)
+  {
+    if (IsIndexed(vtx_desc.high.TexCoord[i]))
+      return true;
+  }
+  return false;
+}
+
+static int RunCachedVertices(VertexLoaderBase* loader, int vtx_attr_group, DataReader src,
+                             DataReader dst, int count, CachedVertices* cache)
+{
+  const TVtxDesc& vtx_desc = g_main_cp_state.vtx_desc;
+  const VertexLoaderUID uid(vtx_desc, g_main_cp_state.vtx_attr[vtx_attr_group]);
+  if (!cache->data.empty() && cache->loader_uid == uid && cache->count_in == count)
+  {
+    std::memcpy(dst.GetPointer(), cache->data.data(), cache->data.size());
+    std::memcpy(position_cache, cache->position_cache, sizeof(position_cache));
+    if (vtx_desc.low.PosMatIdx)
+      std::copy_n(cache->position_matrix_index + 1, 3, position_matrix_index + 1);
+    loader->m_numLoadedVertices += count;
+    INCSTAT(g_stats.this_frame.num_cached_prims);
+    return cache->count_out;
+  }
+
+  const int count_out = loader->RunVertices(src, dst, count);
+
+  // With fewer than three vertices, the zfreeze position cache keeps values from earlier
+  // primitives, which replaying would overwrite.
+  cache->data.clear();
+  if (count < 3 || UsesVertexArrays(vtx_desc))
+    return count_out;
+
+  cache->loader_uid = uid;
+  cache->count_in = count;
+  cache->count_out = count_out;
+  const u8* data = dst.GetPointer();
+  cache->data.assign(data, data + count_out * loader->m_native_vtx_decl.stride);
+  std::memcpy(cache->position_cache, position_cache, sizeof(position_cache));
+  std::copy_n(position_matrix_index, 4, cache->position_matrix_index);
+  return count_out;
+}
+
+int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess,
+                CachedVertices* cache)
 {
   if (!count)
     return 0;
@@ -272,7 +325,10 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  if (cache)
+    count = RunCachedVertices(loader, vtx_attr_group, src, dst, count, cache);
+  else
+    count = loader->RunVertices(src, dst, count);
 
   g_vertex_manager->AddIndices(primitive, count);
   g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
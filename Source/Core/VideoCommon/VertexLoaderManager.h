@@ -7,9 +7,11 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoCommon/CPMemory.h"
+#include "VideoCommon/VertexLoaderBase.h"
 
 class DataReader;
 class NativeVertexFormat;
@@ -35,8 +37,24 @@ NativeVertexFormat* GetOrCreateMatchingFormat(const PortableVertexDeclaration& d
 // offsets set to the unused attributes.
 NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 
-// Returns -1 if buf_size is insufficient, else the amount of bytes consumed
-int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess);
+// The converted vertices of one primitive command, as recorded by the display list cache. They
+// are only replayed while the vertex format matches, and never for formats that read vertex
+// arrays, whose contents aren't part of the command.
+struct CachedVertices
+{
+  VertexLoaderUID loader_uid;
+  int count_in = 0;
+  int count_out = 0;
+  std::vector<u8> data;
+  float position_cache[3][4];
+  u32 position_matrix_index[4];
+};
+
+// Returns -1 if buf_size is insufficient, else the amount of bytes consumed.
+// If cache is set, the vertices are copied from it when it matches the command, and recorded to it
+// otherwise.
+int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess,
+                CachedVertices* cache = nullptr);
 
 NativeVertexFormat* GetCurrentVertexFormat();
 
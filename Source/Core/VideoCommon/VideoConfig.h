@@ -66,6 +66,7 @@ struct VideoConfig final
   AspectMode suggested_aspect_mode;
   bool bCrop;  // Aspect ratio controls.
   bool bShaderCache;
+  bool bDisplayListCache;
 
   // Enhancements
   u32 iMultisamples;
@@ -99,6 +100,7 @@ struct VideoConfig final
   bool bDumpBaseTextures;
   bool bHiresTextures;
   bool bCacheHiresTextures;
+  int iHiresTexturesCacheSize;  // in MiB
   bool bDumpEFBTarget;
   bool bDumpXFBTarget;
   bool bDumpFramesAsImages;
@@ -110,6 +112,9 @@ struct VideoConfig final
   bool bInternalResolutionFrameDumps;
   bool bBorderlessFullscreen;
   bool bEnableGPUTextureDecoding;
+  // Number of threads decoding textures on the CPU, including the video thread.
+  // 0 or 1 decodes on the video thread only, -1 uses an automatic number.
+  int iTextureDecodingThreads;
   int iBitrateKbps;
 
   // Hacks
@@ -156,6 +161,8 @@ struct VideoConfig final
   bool bDumpObjects;
   bool bDumpTevStages;
   bool bDumpTevTextureFetches;
+  int iSWRasterizerThreads;
+  bool bSWTevJit;
 
   // Enable API validation layers, currently only supported with Vulkan.
   bool bEnableValidationLayer;
@@ -177,6 +184,13 @@ struct VideoConfig final
   int iShaderCompilerThreads;
   int iShaderPrecompilerThreads;
 
+  // Creates the shaders and pipelines from the disk caches on the precompiler threads.
+  bool bParallelShaderCacheLoading;
+
+  // Compiles the cached pipelines in the order the game needed them in previous sessions, instead
+  // of all at once at startup. Only used without waiting for shaders before starting.
+  bool bPredictiveShaderCompilation;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -241,6 +255,8 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetTextureDecodingThreads() const;
+  u32 GetSWRasterizerThreads() const;
 };
 
 extern VideoConfig g_Config;
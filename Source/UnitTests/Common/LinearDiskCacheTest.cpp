@@ -0,0 +1,182 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+class Reader final : public LinearDiskCacheReader<u32, u8>
+{
+public:
+  void Read(const u32& key, const u8* value, u32 value_size) override
+  {
+    entries.emplace_back(key, std::string(value, value + value_size));
+  }
+
+  std::vector<std::pair<u32, std::string>> entries;
+};
+
+void Append(LinearDiskCache<u32, u8>& cache, u32 key, const std::string& value)
+{
+  cache.Append(key, reinterpret_cast<const u8*>(value.data()), static_cast<u32>(value.size()));
+}
+
+std::string Lookup(const LinearDiskCache<u32, u8>& cache, u32 key)
+{
+  u32 size = 0;
+  const u8* value = cache.Lookup(key, &size);
+  return value ? std::string(value, value + size) : "<none>";
+}
+}  // namespace
+
+class LinearDiskCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    ASSERT_FALSE(m_directory.empty());
+    m_filename = m_directory + "/test.cache";
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  std::vector<std::pair<u32, std::string>> ReadAll()
+  {
+    LinearDiskCache<u32, u8> cache;
+    Reader reader;
+    cache.OpenAndRead(m_filename, reader);
+    return reader.entries;
+  }
+
+  std::string m_directory;
+  std::string m_filename;
+};
+
+TEST_F(LinearDiskCacheTest, RoundTrip)
+{
+  {
+    LinearDiskCache<u32, u8> cache;
+    EXPECT_EQ(0u, cache.Open(m_filename));
+    Append(cache, 3, "three");
+    Append(cache, 1, "one");
+    Append(cache, 2, "");
+  }
+
+  using Entries = std::vector<std::pair<u32, std::string>>;
+  EXPECT_EQ(Entries({{3, "three"}, {1, "one"}, {2, ""}}), ReadAll());
+
+  LinearDiskCache<u32, u8> cache;
+  EXPECT_EQ(3u, cache.Open(m_filename));
+  EXPECT_EQ("one", Lookup(cache, 1));
+  EXPECT_EQ("", Lookup(cache, 2));
+  EXPECT_EQ("<none>", Lookup(cache, 4));
+
+  // Values appended after opening only show up the next time.
+  Append(cache, 4, "four");
+  EXPECT_EQ("<none>", Lookup(cache, 4));
+  EXPECT_EQ("three", Lookup(cache, 3));
+  cache.Close();
+
+  EXPECT_EQ(4u, cache.Open(m_filename));
+  EXPECT_EQ("four", Lookup(cache, 4));
+  EXPECT_EQ("three", Lookup(cache, 3));
+}
+
+TEST_F(LinearDiskCacheTest, RebuildsMissingIndex)
+{
+  {
+    LinearDiskCache<u32, u8> cache;
+    cache.Open(m_filename);
+    Append(cache, 1, "one");
+    Append(cache, 2, "two");
+  }
+  const u64 indexed_size = File::GetSize(m_filename);
+
+  // Drop the end of the index, as if Dolphin crashed while writing it.
+  {
+    File::IOFile file(m_filename, "r+b");
+    ASSERT_TRUE(file.Resize(indexed_size - 4));
+  }
+
+  using Entries = std::vector<std::pair<u32, std::string>>;
+  EXPECT_EQ(Entries({{1, "one"}, {2, "two"}}), ReadAll());
+  // Reading the pairs rewrote the index.
+  EXPECT_EQ(indexed_size, File::GetSize(m_filename));
+
+  // Same for a file which ends in the middle of a pair. The index takes up 2 * 16 + 24 bytes.
+  {
+    File::IOFile file(m_filename, "r+b");
+    ASSERT_TRUE(file.Resize(indexed_size - 56 - 5));
+  }
+  EXPECT_EQ(Entries({{1, "one"}}), ReadAll());
+
+  // Pairs appended over the index of a file are found.
+  {
+    LinearDiskCache<u32, u8> cache;
+    cache.Open(m_filename);
+    Append(cache, 3, "three");
+  }
+  EXPECT_EQ(Entries({{1, "one"}, {3, "three"}}), ReadAll());
+}
+
+TEST_F(LinearDiskCacheTest, CompactsSupersededPairs)
+{
+  const std::string old_value(1000, 'a');
+  {
+    LinearDiskCache<u32, u8> cache;
+    cache.Open(m_filename);
+    Append(cache, 1, old_value);
+    Append(cache, 2, "two");
+  }
+  const u64 size_before = File::GetSize(m_filename);
+
+  {
+    LinearDiskCache<u32, u8> cache;
+    cache.Open(m_filename);
+    Append(cache, 1, "new one");
+    // The old value is superseded, and the new one can only be looked up after reopening.
+    EXPECT_EQ("<none>", Lookup(cache, 1));
+  }
+
+  // The old value of the first key was dropped when the cache was closed.
+  EXPECT_LT(File::GetSize(m_filename), size_before);
+  EXPECT_FALSE(File::Exists(m_filename + ".compact"));
+
+  using Entries = std::vector<std::pair<u32, std::string>>;
+  EXPECT_EQ(Entries({{2, "two"}, {1, "new one"}}), ReadAll());
+
+  // The compacted file can be appended to.
+  {
+    LinearDiskCache<u32, u8> cache;
+    cache.Open(m_filename);
+    Append(cache, 5, "five");
+  }
+  EXPECT_EQ(Entries({{2, "two"}, {1, "new one"}, {5, "five"}}), ReadAll());
+}
+
+TEST_F(LinearDiskCacheTest, RecreatesInvalidFile)
+{
+  {
+    File::IOFile file(m_filename, "wb");
+    file.WriteString("not a cache");
+  }
+
+  LinearDiskCache<u32, u8> cache;
+  EXPECT_EQ(0u, cache.Open(m_filename));
+  Append(cache, 1, "one");
+  cache.Close();
+
+  using Entries = std::vector<std::pair<u32, std::string>>;
+  EXPECT_EQ(Entries({{1, "one"}}), ReadAll());
+}
@@ -0,0 +1,99 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32> q;
+
+  EXPECT_TRUE(q.Empty());
+
+  q.Push(1);
+  EXPECT_FALSE(q.Empty());
+
+  u32 v;
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_TRUE(q.Empty());
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order.
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    u32 v2;
+    EXPECT_TRUE(q.Pop(v2));
+    EXPECT_EQ(i, v2);
+  }
+  EXPECT_TRUE(q.Empty());
+
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  EXPECT_FALSE(q.Empty());
+  q.Clear();
+  EXPECT_TRUE(q.Empty());
+}
+
+namespace
+{
+constexpr u32 NUM_PRODUCERS = 4;
+constexpr u32 ITEMS_PER_PRODUCER = 100000;
+
+struct Item
+{
+  u32 producer;
+  u32 sequence;
+};
+}  // namespace
+
+// Pushes from several producers while a single consumer drains the queue, checking that no item
+// is lost and that each producer's items arrive in order.
+TEST(MPSCQueue, MultipleProducers)
+{
+  Common::MPSCQueue<Item> q;
+  std::atomic<bool> start{false};
+  std::vector<std::thread> producers;
+  for (u32 producer = 0; producer < NUM_PRODUCERS; ++producer)
+  {
+    producers.emplace_back([&q, &start, producer] {
+      while (!start.load())
+        std::this_thread::yield();
+      for (u32 i = 0; i < ITEMS_PER_PRODUCER; ++i)
+        q.Push(Item{producer, i});
+    });
+  }
+
+  std::vector<u32> next_sequence(NUM_PRODUCERS);
+  start.store(true);
+
+  for (u32 received = 0; received < NUM_PRODUCERS * ITEMS_PER_PRODUCER;)
+  {
+    Item item;
+    if (!q.Pop(item))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    EXPECT_EQ(next_sequence[item.producer], item.sequence);
+    next_sequence[item.producer] = item.sequence + 1;
+    ++received;
+  }
+
+  for (std::thread& producer : producers)
+    producer.join();
+
+  for (u32 sequence : next_sequence)
+    EXPECT_EQ(ITEMS_PER_PRODUCER, sequence);
+  EXPECT_TRUE(q.Empty());
+}
@@ -5,8 +5,11 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -362,3 +365,95 @@ TEST(CoreTiming, Overclocking)
   SConfig::GetInstance().m_OCFactor = 1.0;
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, RemoveEvent)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  CoreTiming::EventType* cb_a = CoreTiming::RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = CoreTiming::RegisterEvent("callbackB", CallbackTemplate<1>);
+  CoreTiming::EventType* cb_c = CoreTiming::RegisterEvent("callbackC", CallbackTemplate<2>);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  CoreTiming::ScheduleEvent(100, cb_b, CB_IDS[1]);
+  CoreTiming::ScheduleEvent(200, cb_a, CB_IDS[0]);
+  CoreTiming::ScheduleEvent(300, cb_b, CB_IDS[1]);
+  CoreTiming::ScheduleEvent(400, cb_c, CB_IDS[2]);
+  CoreTiming::ScheduleEvent(500, cb_b, CB_IDS[1]);
+  EXPECT_EQ(100, PowerPC::ppcState.downcount);
+
+  // Removes every pending event of the type, including the next one to run.
+  CoreTiming::RemoveEvent(cb_b);
+
+  s_callbacks_ran_flags = 0;
+  PowerPC::ppcState.downcount = 0;
+  CoreTiming::Advance();
+  EXPECT_EQ(0u, s_callbacks_ran_flags.count());
+  EXPECT_EQ(100, PowerPC::ppcState.downcount);
+
+  AdvanceAndCheck(0, 200);
+  AdvanceAndCheck(2, MAX_SLICE_LENGTH);
+}
+
+namespace OtherThreadTest
+{
+static std::array<u32, 4> s_next_userdata;
+
+static void OrderedCallback(u64 userdata, s64 lateness)
+{
+  const u32 thread = static_cast<u32>(userdata >> 32);
+  EXPECT_EQ(s_next_userdata[thread], static_cast<u32>(userdata));
+  s_next_userdata[thread] = static_cast<u32>(userdata) + 1;
+}
+}  // namespace OtherThreadTest
+
+TEST(CoreTiming, ScheduleFromOtherThreads)
+{
+  using namespace OtherThreadTest;
+
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  constexpr u32 EVENTS_PER_THREAD = 10000;
+  CoreTiming::EventType* cb = CoreTiming::RegisterEvent("ordered", OrderedCallback);
+  s_next_userdata = {};
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  // Keep advancing while the other threads schedule, so events are moved out of the queue while
+  // it is being pushed to. Events from one thread are scheduled at the same time and must run in
+  // the order they were scheduled in.
+  std::atomic<u32> threads_done{0};
+  std::vector<std::thread> threads;
+  for (u32 thread = 0; thread < s_next_userdata.size(); thread++)
+  {
+    threads.emplace_back([cb, thread, &threads_done] {
+      for (u32 i = 0; i < EVENTS_PER_THREAD; i++)
+      {
+        CoreTiming::ScheduleEvent(0, cb, (u64{thread} << 32) | i,
+                                  CoreTiming::FromThread::NON_CPU);
+      }
+      threads_done++;
+    });
+  }
+
+  while (threads_done.load() < threads.size())
+  {
+    PowerPC::ppcState.downcount = 0;
+    CoreTiming::Advance();
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  PowerPC::ppcState.downcount = 0;
+  CoreTiming::Advance();
+  PowerPC::ppcState.downcount = 0;
+  CoreTiming::Advance();
+
+  for (u32 next_userdata : s_next_userdata)
+    EXPECT_EQ(EVENTS_PER_THREAD, next_userdata);
+}
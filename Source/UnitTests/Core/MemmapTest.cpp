@@ -0,0 +1,72 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/MsgHandler.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+int s_num_alerts = 0;
+
+bool CountAlert(const char* caption, const char* text, bool yes_no, Common::MsgType style)
+{
+  s_num_alerts++;
+  return true;
+}
+}  // namespace
+
+class MemmapTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    Memory::Init();
+    s_num_alerts = 0;
+    Common::RegisterMsgAlertHandler(CountAlert);
+  }
+
+  void TearDown() override
+  {
+    Common::RegisterMsgAlertHandler(nullptr);
+    Memory::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  std::string m_profile_path;
+};
+
+TEST_F(MemmapTest, TryGetPointerForRange)
+{
+  // A texture which ends at the last byte of RAM.
+  const u32 ram_size = Memory::GetRamSizeReal();
+  const u32 texture_size = 0x2000;
+  const u32 address = Memory::MEM1_BASE_ADDR + ram_size - texture_size;
+  EXPECT_EQ(Memory::m_pRAM + ram_size - texture_size,
+            Memory::TryGetPointerForRange(address, texture_size));
+
+  // Mipmaps of the same texture, which extend past the end of RAM.
+  EXPECT_EQ(nullptr, Memory::TryGetPointerForRange(address, texture_size + 1));
+  EXPECT_EQ(nullptr, Memory::TryGetPointerForRange(address, texture_size + 0x10000));
+
+  // A texture which starts past the end of RAM.
+  EXPECT_EQ(nullptr, Memory::TryGetPointerForRange(Memory::MEM1_BASE_ADDR + ram_size, 0x20));
+
+  EXPECT_EQ(0, s_num_alerts);
+}
@@ -0,0 +1,89 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <iterator>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "UICommon/UICommon.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr u32 CODE_ADDRESS = 0x3000;
+constexpr u32 IDLE_ADDRESS = 0x3100;
+
+// cmpw r3, r4; beq +0xC; li r5, 1; b idle; li r5, 2; b idle
+constexpr u32 CODE[] = {0x7C032000, 0x4182000C, 0x38A00001, 0x480000F4, 0x38A00002, 0x480000EC};
+// b .
+constexpr u32 IDLE_LOOP = 0x48000000;
+}  // namespace
+
+class Jit64MergedBranchTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    Config::SetCurrent(Config::MAIN_JIT_TIERED_COMPILATION, true);
+    Config::SetCurrent(Config::MAIN_JIT_INTERPRET_COLD_BLOCKS, false);
+    Config::SetCurrent(Config::MAIN_JIT_PERSISTENT_CACHE, false);
+    SConfig::GetInstance().bFastmem = false;
+    SConfig::GetInstance().bJITFollowBranch = true;
+    Memory::Init();
+    CoreTiming::Init();
+    PowerPC::Init(PowerPC::CPUCore::JIT64);
+
+    for (u32 i = 0; i < std::size(CODE); i++)
+      Memory::Write_U32(CODE[i], CODE_ADDRESS + i * 4);
+    Memory::Write_U32(IDLE_LOOP, IDLE_ADDRESS);
+  }
+
+  void TearDown() override
+  {
+    PowerPC::Shutdown();
+    CoreTiming::Shutdown();
+    Memory::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  // Runs the code until it reaches the idle loop, and returns which path it took.
+  u32 Run(u32 r3, u32 r4)
+  {
+    PowerPC::ppcState.gpr[3] = r3;
+    PowerPC::ppcState.gpr[4] = r4;
+    PowerPC::ppcState.gpr[5] = 0;
+    PowerPC::ppcState.pc = CODE_ADDRESS;
+    PowerPC::SingleStep();
+    EXPECT_EQ(IDLE_ADDRESS, PowerPC::ppcState.pc);
+    return PowerPC::ppcState.gpr[5];
+  }
+
+  std::string m_profile_path;
+};
+
+TEST_F(Jit64MergedBranchTest, FollowedBranchNotTaken)
+{
+  // Make the block and its branch hot, so that the optimized tier follows the branch and merges
+  // it with the cmp.
+  for (int i = 0; i < 2000; i++)
+    ASSERT_EQ(2u, Run(1, 1));
+
+  EXPECT_EQ(1u, Run(1, 2));
+  EXPECT_EQ(2u, Run(2, 2));
+}
@@ -0,0 +1,132 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <set>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+class JitCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override { m_cache.Clear(); }
+
+  JitBlock* AddBlock(u32 address, u32 num_instructions, u32 exit_address = 0)
+  {
+    JitBlock* block = m_cache.AllocateBlock(address);
+    block->checkedEntry = nullptr;
+    block->normalEntry = nullptr;
+    block->originalSize = num_instructions;
+    if (exit_address != 0)
+      block->linkData.push_back({nullptr, exit_address, false, false});
+
+    std::set<u32> physical_addresses;
+    for (u32 i = 0; i < num_instructions; i++)
+      physical_addresses.insert(address + i * 4);
+    m_cache.FinalizeBlock(*block, exit_address != 0, physical_addresses);
+    return block;
+  }
+
+  size_t CountBlocks()
+  {
+    size_t count = 0;
+    m_cache.RunOnBlocks([&count](const JitBlock&) { count++; });
+    return count;
+  }
+
+  CachedInterpreter m_jit;
+  JitBaseBlockCache& m_cache = *m_jit.GetBlockCache();
+};
+}  // namespace
+
+TEST_F(JitCacheTest, Lookup)
+{
+  JitBlock* a = AddBlock(0x1000, 8);
+  JitBlock* b = AddBlock(0x2000, 8);
+
+  EXPECT_EQ(a, m_cache.GetBlockFromStartAddress(0x1000, 0));
+  EXPECT_EQ(b, m_cache.GetBlockFromStartAddress(0x2000, 0));
+  EXPECT_EQ(nullptr, m_cache.GetBlockFromStartAddress(0x1004, 0));
+  // Same address, but compiled with data address translation enabled.
+  EXPECT_EQ(nullptr, m_cache.GetBlockFromStartAddress(0x1000, 0x10));
+  EXPECT_EQ(2u, CountBlocks());
+}
+
+TEST_F(JitCacheTest, ErasePhysicalRange)
+{
+  AddBlock(0x1000, 4);
+  AddBlock(0x1010, 4);
+  AddBlock(0x1100, 4);
+
+  // Only the block containing 0x1014 may be removed.
+  m_cache.ErasePhysicalRange(0x1014, 4);
+  EXPECT_NE(nullptr, m_cache.GetBlockFromStartAddress(0x1000, 0));
+  EXPECT_EQ(nullptr, m_cache.GetBlockFromStartAddress(0x1010, 0));
+  EXPECT_NE(nullptr, m_cache.GetBlockFromStartAddress(0x1100, 0));
+
+  // A range covering nothing doesn't remove anything.
+  m_cache.ErasePhysicalRange(0x1020, 0xE0);
+  EXPECT_EQ(2u, CountBlocks());
+
+  m_cache.ErasePhysicalRange(0, 0xFFFFFFFF);
+  EXPECT_EQ(0u, CountBlocks());
+}
+
+TEST_F(JitCacheTest, EraseBlockSpanningMacroBlocks)
+{
+  // This block occupies three macro blocks of the range map.
+  AddBlock(0x10F0, 0x48);
+
+  m_cache.ErasePhysicalRange(0x1200, 4);
+  EXPECT_EQ(nullptr, m_cache.GetBlockFromStartAddress(0x10F0, 0));
+
+  // Reusing the freed slot must not be affected by stale range map entries.
+  JitBlock* block = AddBlock(0x1100, 4);
+  m_cache.ErasePhysicalRange(0x1200, 4);
+  EXPECT_EQ(block, m_cache.GetBlockFromStartAddress(0x1100, 0));
+}
+
+TEST_F(JitCacheTest, LinkedBlocks)
+{
+  AddBlock(0x1000, 4, 0x2000);
+  AddBlock(0x2000, 4, 0x1000);
+
+  m_cache.ErasePhysicalRange(0x2000, 4);
+  EXPECT_EQ(nullptr, m_cache.GetBlockFromStartAddress(0x2000, 0));
+
+  // Re-adding the destination must relink cleanly.
+  AddBlock(0x2000, 4, 0x1000);
+  m_cache.ErasePhysicalRange(0x1000, 4);
+  EXPECT_EQ(1u, CountBlocks());
+}
+
+TEST_F(JitCacheTest, ManyBlocks)
+{
+  // Enough blocks for the address maps to grow several times, and erasing every other one moves
+  // entries around within the clusters of the maps.
+  constexpr u32 NUM_BLOCKS = 0x1000;
+  for (u32 i = 0; i < NUM_BLOCKS; i++)
+    AddBlock(0x100000 + i * 0x40, 4, 0x100000 + ((i + 1) % NUM_BLOCKS) * 0x40);
+
+  for (u32 i = 0; i < NUM_BLOCKS; i += 2)
+    m_cache.ErasePhysicalRange(0x100000 + i * 0x40, 4);
+
+  for (u32 i = 0; i < NUM_BLOCKS; i++)
+  {
+    JitBlock* block = m_cache.GetBlockFromStartAddress(0x100000 + i * 0x40, 0);
+    if (i % 2 == 0)
+      EXPECT_EQ(nullptr, block);
+    else
+      ASSERT_NE(nullptr, block);
+  }
+  EXPECT_EQ(NUM_BLOCKS / 2, CountBlocks());
+
+  m_cache.ErasePhysicalRange(0x100000, NUM_BLOCKS * 0x40);
+  EXPECT_EQ(0u, CountBlocks());
+}
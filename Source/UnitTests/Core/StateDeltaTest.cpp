@@ -0,0 +1,108 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
+
+using State::StateDelta;
+
+static std::vector<u8> MakeState(size_t size, u8 seed)
+{
+  std::vector<u8> state(size);
+  std::iota(state.begin(), state.end(), seed);
+  return state;
+}
+
+TEST(StateDelta, OnlyStoresChangedPages)
+{
+  const std::vector<u8> reference = MakeState(StateDelta::PAGE_SIZE * 8, 0);
+  std::vector<u8> state = reference;
+  state[StateDelta::PAGE_SIZE * 2 + 5] ^= 0xFF;
+  state[StateDelta::PAGE_SIZE * 7] ^= 0xFF;
+
+  const StateDelta delta(reference, state);
+  EXPECT_EQ(2u, delta.GetNumPages());
+  EXPECT_EQ(state.size(), delta.GetStateSize());
+
+  std::vector<u8> buffer = reference;
+  delta.Apply(&buffer);
+  EXPECT_EQ(state, buffer);
+
+  EXPECT_EQ(0u, StateDelta(state, state).GetNumPages());
+}
+
+TEST(StateDelta, SizeChanges)
+{
+  const std::vector<u8> reference = MakeState(StateDelta::PAGE_SIZE * 4 + 100, 0);
+
+  std::vector<u8> grown = reference;
+  grown.resize(grown.size() + StateDelta::PAGE_SIZE, 0x55);
+  std::vector<u8> buffer = reference;
+  StateDelta(reference, grown).Apply(&buffer);
+  EXPECT_EQ(grown, buffer);
+
+  std::vector<u8> shrunk = reference;
+  shrunk.resize(StateDelta::PAGE_SIZE * 2 + 1);
+  const StateDelta shrink_delta(reference, shrunk);
+  EXPECT_EQ(0u, shrink_delta.GetNumPages());
+  buffer = reference;
+  shrink_delta.Apply(&buffer);
+  EXPECT_EQ(shrunk, buffer);
+}
+
+TEST(StateDelta, Compact)
+{
+  const std::vector<u8> state0 = MakeState(StateDelta::PAGE_SIZE * 6 + 10, 0);
+  std::vector<u8> state1 = state0;
+  state1[0] = 0xAA;
+  state1[StateDelta::PAGE_SIZE * 3] = 0xAA;
+  state1[StateDelta::PAGE_SIZE * 6 + 3] = 0xAA;
+  std::vector<u8> state2 = state1;
+  state2[StateDelta::PAGE_SIZE * 3 + 1] = 0xBB;
+  state2[StateDelta::PAGE_SIZE * 5] = 0xBB;
+  state2.resize(StateDelta::PAGE_SIZE * 6 + 5);
+
+  StateDelta delta(state0, state1);
+  delta.Compact(StateDelta(state1, state2));
+  EXPECT_EQ(4u, delta.GetNumPages());
+
+  std::vector<u8> buffer = state0;
+  delta.Apply(&buffer);
+  EXPECT_EQ(state2, buffer);
+}
+
+TEST(StateDelta, DoState)
+{
+  const std::vector<u8> reference = MakeState(StateDelta::PAGE_SIZE * 3 + 7, 0);
+  std::vector<u8> state = reference;
+  state[StateDelta::PAGE_SIZE] = 0xCC;
+  state.push_back(0xDD);
+  StateDelta delta(reference, state);
+
+  std::vector<u8> serialized;
+  u8* ptr = nullptr;
+  PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
+  delta.DoState(p);
+  serialized.resize(reinterpret_cast<size_t>(ptr));
+  ptr = serialized.data();
+  p.SetMode(PointerWrap::MODE_WRITE);
+  delta.DoState(p);
+
+  StateDelta loaded;
+  ptr = serialized.data();
+  p.SetMode(PointerWrap::MODE_READ);
+  loaded.DoState(p);
+  ASSERT_EQ(PointerWrap::MODE_READ, p.GetMode());
+  EXPECT_EQ(delta.GetNumPages(), loaded.GetNumPages());
+
+  std::vector<u8> buffer = reference;
+  loaded.Apply(&buffer);
+  EXPECT_EQ(state, buffer);
+}
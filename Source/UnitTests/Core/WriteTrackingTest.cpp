@@ -0,0 +1,165 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemTools.h"
+#include "Core/PowerPC/MMU.h"
+#include "UICommon/UICommon.h"
+
+class WriteTrackingTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    Memory::Init();
+    EMM::InstallExceptionHandler();
+    Memory::SetWriteTrackingEnabled(true);
+  }
+
+  void TearDown() override
+  {
+    Memory::SetWriteTrackingEnabled(false);
+    EMM::UninstallExceptionHandler();
+    Memory::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  std::string m_profile_path;
+};
+
+TEST_F(WriteTrackingTest, DetectsWrites)
+{
+  if (!EMM::HandlesAllThreads())
+    return;
+
+  const u64 token = Memory::TrackWrites(0x1000, 0x2000);
+  ASSERT_NE(0u, token);
+  EXPECT_FALSE(Memory::WrittenSince(0x1000, 0x2000, token));
+  EXPECT_FALSE(Memory::WrittenSince(0x80001000, 0x2000, token));
+
+  Memory::m_pRAM[0x8000] = 1;
+  EXPECT_FALSE(Memory::WrittenSince(0x1000, 0x2000, token));
+
+  Memory::m_pRAM[0x2800] = 1;
+  EXPECT_TRUE(Memory::WrittenSince(0x1000, 0x2000, token));
+  EXPECT_EQ(1, Memory::m_pRAM[0x2800]);
+}
+
+TEST_F(WriteTrackingTest, DetectsWritesFromOtherThreads)
+{
+  if (!EMM::HandlesAllThreads())
+    return;
+
+  const u64 token = Memory::TrackWrites(0x1000, 0x100);
+  std::thread([] { Memory::Write_U32(5, 0x1004); }).join();
+  EXPECT_TRUE(Memory::WrittenSince(0x1000, 0x100, token));
+  EXPECT_EQ(5u, Memory::Read_U32(0x1004));
+}
+
+TEST_F(WriteTrackingTest, DetectsWritesThroughFastmem)
+{
+  if (!EMM::HandlesAllThreads())
+    return;
+
+  ASSERT_TRUE(Memory::InitFastmemArena());
+  const u64 token = Memory::TrackWrites(0x10000, 0x100);
+  EXPECT_FALSE(Memory::WrittenSince(0x10000, 0x100, token));
+
+  Memory::physical_base[0x10080] = 7;
+  EXPECT_TRUE(Memory::WrittenSince(0x10000, 0x100, token));
+  EXPECT_EQ(7, Memory::m_pRAM[0x10080]);
+  Memory::ShutdownFastmemArena();
+}
+
+TEST_F(WriteTrackingTest, DetectsWritesThroughLogicalFastmem)
+{
+  if (!EMM::HandlesAllThreads())
+    return;
+
+  ASSERT_TRUE(Memory::InitFastmemArena());
+  if (!Memory::logical_base)
+  {
+    Memory::ShutdownFastmemArena();
+    return;
+  }
+
+  // Map 0x80020000 to the physical page at 0x00040000.
+  PowerPC::BatTable dbat_table{};
+  dbat_table[0x80020000 >> PowerPC::BAT_INDEX_SHIFT] = 0x00040000 | PowerPC::BAT_PHYSICAL_BIT;
+  Memory::UpdateLogicalMemory(dbat_table);
+  const u64 token = Memory::TrackWrites(0x40000, 0x1000);
+
+  Memory::logical_base[0x80020800] = 9;
+  EXPECT_TRUE(Memory::WrittenSince(0x40000, 0x1000, token));
+  EXPECT_EQ(9, Memory::m_pRAM[0x40800]);
+  Memory::ShutdownFastmemArena();
+}
+
+TEST_F(WriteTrackingTest, RetrackingPageWrittenThroughOtherView)
+{
+  if (!EMM::HandlesAllThreads())
+    return;
+
+  ASSERT_TRUE(Memory::InitFastmemArena());
+  const u64 first = Memory::TrackWrites(0x30000, 0x100);
+
+  // The fault handler only unprotects the view which was written to.
+  Memory::m_pRAM[0x30000] = 1;
+  Memory::physical_base[0x30010] = 2;
+  EXPECT_TRUE(Memory::WrittenSince(0x30000, 0x100, first));
+
+  const u64 second = Memory::TrackWrites(0x30000, 0x100);
+  EXPECT_FALSE(Memory::WrittenSince(0x30000, 0x100, second));
+
+  Memory::physical_base[0x30020] = 3;
+  EXPECT_TRUE(Memory::WrittenSince(0x30000, 0x100, second));
+
+  const u64 third = Memory::TrackWrites(0x30000, 0x100);
+  Memory::m_pRAM[0x30030] = 4;
+  EXPECT_TRUE(Memory::WrittenSince(0x30000, 0x100, third));
+  EXPECT_EQ(2, Memory::m_pRAM[0x30010]);
+  EXPECT_EQ(3, Memory::m_pRAM[0x30020]);
+  EXPECT_EQ(4, Memory::physical_base[0x30030]);
+  Memory::ShutdownFastmemArena();
+}
+
+TEST_F(WriteTrackingTest, RetrackingSharedPage)
+{
+  if (!EMM::HandlesAllThreads())
+    return;
+
+  const u64 first = Memory::TrackWrites(0x20000, 0x10);
+  const u64 second = Memory::TrackWrites(0x20100, 0x10);
+  Memory::m_pRAM[0x20000] = 1;
+
+  // Both ranges share a page, so either of them being written dirties the other as well.
+  const u64 first_again = Memory::TrackWrites(0x20000, 0x10);
+  EXPECT_TRUE(Memory::WrittenSince(0x20000, 0x10, first));
+  EXPECT_TRUE(Memory::WrittenSince(0x20100, 0x10, second));
+  EXPECT_FALSE(Memory::WrittenSince(0x20000, 0x10, first_again));
+
+  Memory::m_pRAM[0x20100] = 1;
+  EXPECT_TRUE(Memory::WrittenSince(0x20000, 0x10, first_again));
+}
+
+TEST_F(WriteTrackingTest, RejectsInvalidRanges)
+{
+  EXPECT_EQ(0u, Memory::TrackWrites(0x0C000000, 0x10));
+}
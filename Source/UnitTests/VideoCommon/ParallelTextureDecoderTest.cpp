@@ -0,0 +1,126 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/ParallelTextureDecoder.h"
+#include "VideoCommon/TextureDecoder.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Every format which _TexDecoder_DecodeImpl handles.
+constexpr TextureFormat FORMATS[] = {
+    TextureFormat::I4,
+    TextureFormat::I8,
+    TextureFormat::IA4,
+    TextureFormat::IA8,
+    TextureFormat::RGB565,
+    TextureFormat::RGB5A3,
+    TextureFormat::RGBA8,
+    TextureFormat::C4,
+    TextureFormat::C8,
+    TextureFormat::C14X2,
+    TextureFormat::CMPR,
+    TextureFormat::XFB,
+};
+
+struct Level
+{
+  int width;
+  int height;
+  std::vector<u8> src;
+};
+
+// A mipmap chain, with random texture data.
+std::vector<Level> CreateLevels(TextureFormat format, int width, int height, std::mt19937& rng)
+{
+  std::vector<Level> levels;
+  while (width >= 8 && height >= 8)
+  {
+    std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(width, height, format));
+    std::generate(src.begin(), src.end(), [&] { return static_cast<u8>(rng()); });
+    levels.push_back({width, height, std::move(src)});
+    width /= 2;
+    height /= 2;
+  }
+  return levels;
+}
+
+std::vector<u8> CreateTlut(std::mt19937& rng)
+{
+  // Large enough for C14X2.
+  std::vector<u8> tlut(2 << 14);
+  std::generate(tlut.begin(), tlut.end(), [&] { return static_cast<u8>(rng()); });
+  return tlut;
+}
+
+std::vector<std::vector<u8>> AllocateDecodedLevels(const std::vector<Level>& levels)
+{
+  std::vector<std::vector<u8>> decoded;
+  for (const Level& level : levels)
+    decoded.emplace_back(static_cast<size_t>(level.width) * level.height * sizeof(u32));
+  return decoded;
+}
+
+void Decode(VideoCommon::ParallelTextureDecoder& decoder, const std::vector<Level>& levels,
+            TextureFormat format, const std::vector<u8>& tlut,
+            std::vector<std::vector<u8>>* decoded)
+{
+  for (size_t i = 0; i < levels.size(); i++)
+  {
+    decoder.QueueLevel((*decoded)[i].data(), levels[i].src.data(), levels[i].width,
+                       levels[i].height, format, tlut.data(), TLUTFormat::RGB5A3);
+  }
+  decoder.Finish();
+}
+}  // namespace
+
+TEST(ParallelTextureDecoder, MatchesTexDecoderDecode)
+{
+  std::mt19937 rng(0);
+  const std::vector<u8> tlut = CreateTlut(rng);
+  VideoCommon::ParallelTextureDecoder decoder(4);
+
+  for (TextureFormat format : FORMATS)
+  {
+    // The first level is large enough to be split into ranges, the last ones are not.
+    const std::vector<Level> levels = CreateLevels(format, 1024, 512, rng);
+    std::vector<std::vector<u8>> decoded = AllocateDecodedLevels(levels);
+    Decode(decoder, levels, format, tlut, &decoded);
+
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+      std::vector<u8> expected(decoded[i].size());
+      TexDecoder_Decode(expected.data(), levels[i].src.data(), levels[i].width, levels[i].height,
+                        format, tlut.data(), TLUTFormat::RGB5A3);
+      EXPECT_EQ(expected, decoded[i]) << fmt::format("{} level {}", format, i);
+    }
+  }
+}
+
+TEST(ParallelTextureDecoder, IndicesRestartAfterFinish)
+{
+  std::mt19937 rng(1);
+  const std::vector<u8> tlut = CreateTlut(rng);
+  const std::vector<Level> levels = CreateLevels(TextureFormat::I8, 64, 64, rng);
+  std::vector<u8> dst(64 * 64 * sizeof(u32));
+
+  VideoCommon::ParallelTextureDecoder decoder(2);
+  EXPECT_EQ(0u, decoder.QueueLevel(dst.data(), levels[0].src.data(), 64, 64, TextureFormat::I8,
+                                   tlut.data(), TLUTFormat::RGB5A3));
+  EXPECT_EQ(1u, decoder.QueueLevel(dst.data(), levels[0].src.data(), 64, 64, TextureFormat::I8,
+                                   tlut.data(), TLUTFormat::RGB5A3));
+  decoder.WaitForLevel(1);
+  decoder.Finish();
+  EXPECT_EQ(0u, decoder.QueueLevel(dst.data(), levels[0].src.data(), 64, 64, TextureFormat::I8,
+                                   tlut.data(), TLUTFormat::RGB5A3));
+  decoder.Finish();
+}
@@ -0,0 +1,191 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureCacheIndex.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+u32 GetValue(TextureAddressIndex<u32>::iterator it)
+{
+  return *it;
+}
+
+u32 GetValue(std::multimap<u32, u32>::iterator it)
+{
+  return it->second;
+}
+
+template <typename Iterator>
+std::vector<u32> GetValues(Iterator first, Iterator last)
+{
+  std::vector<u32> values;
+  for (; first != last; ++first)
+    values.push_back(GetValue(first));
+  return values;
+}
+
+std::vector<std::pair<u32, u32>> GetContents(TextureAddressIndex<u32>& index)
+{
+  std::vector<std::pair<u32, u32>> contents;
+  for (auto it = index.begin(); it != index.end(); ++it)
+    contents.emplace_back(it.address(), *it);
+  return contents;
+}
+
+std::vector<std::pair<u32, u32>> GetContents(const std::multimap<u32, u32>& map)
+{
+  return {map.begin(), map.end()};
+}
+}  // namespace
+
+TEST(TextureAddressIndex, MatchesMultimap)
+{
+  TextureAddressIndex<u32> index;
+  std::multimap<u32, u32> reference;
+
+  std::mt19937 rng(0x1234);
+  // Few distinct addresses over a couple of pages, so that values share addresses and pages.
+  std::uniform_int_distribution<u32> address_dist(0, 0x3000 / 32);
+  u32 next_value = 1;
+  for (int i = 0; i < 20000; i++)
+  {
+    const u32 address = 0x80000 + address_dist(rng) * 32;
+    switch (rng() % 4)
+    {
+    case 0:
+    case 1:
+      index.emplace(address, next_value);
+      reference.emplace(address, next_value);
+      next_value++;
+      break;
+    case 2:
+    {
+      auto [first, last] = index.equal_range(address);
+      auto [ref_first, ref_last] = reference.equal_range(address);
+      ASSERT_EQ(GetValues(ref_first, ref_last), GetValues(first, last));
+      if (first != last)
+      {
+        index.erase(first);
+        reference.erase(ref_first);
+      }
+      break;
+    }
+    case 3:
+    {
+      const u32 end_address = address + address_dist(rng) * 4;
+      ASSERT_EQ(GetValues(reference.lower_bound(address), reference.upper_bound(end_address)),
+                GetValues(index.lower_bound(address), index.upper_bound(end_address)));
+      break;
+    }
+    }
+    ASSERT_EQ(reference.size(), index.size());
+  }
+  EXPECT_EQ(GetContents(reference), GetContents(index));
+
+  // Erase everything while iterating, like TextureCacheBase::Cleanup does.
+  for (auto it = index.begin(); it != index.end();)
+    it = index.erase(it);
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.begin(), index.end());
+}
+
+TEST(TextureAddressIndex, FindsValuesOnOtherPages)
+{
+  TextureAddressIndex<u32> index;
+  index.emplace(0x1000, 1);
+  index.emplace(0x0FFFFFE0, 2);
+  // Beyond the range of texture addresses, which share the last page.
+  index.emplace(0xFFFFFFE0, 3);
+  index.emplace(0x20000000, 4);
+
+  EXPECT_EQ(std::vector<u32>({1, 2, 4, 3}), GetValues(index.begin(), index.end()));
+  EXPECT_EQ(2u, *index.lower_bound(0x1020));
+  EXPECT_EQ(2u, *index.upper_bound(0x1000));
+  EXPECT_EQ(4u, *index.lower_bound(0x10000000));
+  EXPECT_EQ(3u, *index.upper_bound(0x20000000));
+  EXPECT_EQ(index.end(), index.upper_bound(0xFFFFFFE0));
+  EXPECT_EQ(1u, *index.lower_bound(0));
+}
+
+TEST(TextureAddressIndex, IteratorsSurviveModification)
+{
+  TextureAddressIndex<u32> index;
+  const auto first = index.emplace(0x2000, 1);
+  const auto second = index.emplace(0x2000, 2);
+  for (u32 i = 0; i < 1000; i++)
+    index.emplace(0x2000 + (i % 3) * 32, 100 + i);
+
+  EXPECT_EQ(1u, *first);
+  EXPECT_EQ(2u, *second);
+
+  // Erasing a value returns the one after it, which is still the one inserted right after.
+  EXPECT_EQ(second, index.erase(first));
+  EXPECT_EQ(2u, *index.begin());
+
+  // Erased slots are reused by later insertions.
+  index.emplace(0x1000, 5);
+  EXPECT_EQ(5u, *index.begin());
+  EXPECT_EQ(1002u, index.size());
+}
+
+TEST(TextureHashIndex, MatchesMultimap)
+{
+  TextureHashIndex<u32> index;
+  std::multimap<u64, u32> reference;
+
+  std::mt19937_64 rng(0x5678);
+  // A small number of hashes, so that they collide often and have several values each.
+  std::uniform_int_distribution<u64> hash_dist(0, 300);
+  u32 next_value = 1;
+  for (int i = 0; i < 50000; i++)
+  {
+    const u64 hash = hash_dist(rng) * 0x100000001ULL;
+    auto [ref_first, ref_last] = reference.equal_range(hash);
+    switch (rng() % 3)
+    {
+    case 0:
+      index.emplace(hash, next_value);
+      reference.emplace(hash, next_value);
+      next_value++;
+      break;
+    case 1:
+    {
+      std::vector<u32> found;
+      EXPECT_EQ(0u, index.find_if(hash, [&](u32 value) {
+        found.push_back(value);
+        return false;
+      }));
+      std::vector<u32> expected;
+      for (auto it = ref_first; it != ref_last; ++it)
+        expected.push_back(it->second);
+      std::sort(found.begin(), found.end());
+      ASSERT_EQ(expected, found);
+      break;
+    }
+    case 2:
+      if (ref_first != ref_last)
+      {
+        const auto victim = std::next(ref_first, rng() % std::distance(ref_first, ref_last));
+        EXPECT_TRUE(index.erase(hash, victim->second));
+        EXPECT_FALSE(index.erase(hash, victim->second));
+        reference.erase(victim);
+      }
+      break;
+    }
+    ASSERT_EQ(reference.size(), index.size());
+  }
+
+  std::multimap<u64, u32> contents(index.begin(), index.end());
+  EXPECT_EQ(reference, contents);
+}
@@ -0,0 +1,148 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+#include <gtest/gtest.h>
+
+// TextureDecoder_Generic.cpp is only built on architectures without optimized decoders. Build it
+// here under a different name, so that the optimized decoders can be compared against it.
+void TexDecoder_DecodeImpl_Generic(u32* dst, const u8* src, int width, int height,
+                                   TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt);
+#define _TexDecoder_DecodeImpl TexDecoder_DecodeImpl_Generic
+#include "VideoCommon/TextureDecoder_Generic.cpp"
+#undef _TexDecoder_DecodeImpl
+
+namespace
+{
+constexpr TextureFormat FORMATS[] = {
+    TextureFormat::I4,
+    TextureFormat::I8,
+    TextureFormat::IA4,
+    TextureFormat::IA8,
+    TextureFormat::RGB565,
+    TextureFormat::RGB5A3,
+    TextureFormat::RGBA8,
+    TextureFormat::C4,
+    TextureFormat::C8,
+    TextureFormat::C14X2,
+    TextureFormat::CMPR,
+    TextureFormat::XFB,
+};
+
+constexpr TLUTFormat TLUT_FORMATS[] = {TLUTFormat::IA8, TLUTFormat::RGB565, TLUTFormat::RGB5A3};
+
+bool IsPaletted(TextureFormat format)
+{
+  return format == TextureFormat::C4 || format == TextureFormat::C8 ||
+         format == TextureFormat::C14X2;
+}
+
+// The TextureFormat formatter only knows the formats of the texture registers.
+std::string GetName(TextureFormat format)
+{
+  return format == TextureFormat::XFB ? "XFB" : fmt::format("{}", format);
+}
+
+std::vector<u8> CreateRandomData(size_t size, bool few_values, std::mt19937& rng)
+{
+  // Drawing from only a few values makes equal colors in CMPR blocks and other edge cases likely.
+  std::vector<u8> data(size);
+  std::generate(data.begin(), data.end(), [&] {
+    return few_values ? static_cast<u8>((rng() % 3) * 0x7F) : static_cast<u8>(rng());
+  });
+  return data;
+}
+
+std::vector<u32> Decode(TextureFormat format, const std::vector<u8>& src, int width, int height,
+                        const std::vector<u8>& tlut, TLUTFormat tlut_format)
+{
+  std::vector<u32> dst(static_cast<size_t>(width) * height);
+  _TexDecoder_DecodeImpl(dst.data(), src.data(), width, height, format, tlut.data(), tlut_format);
+  return dst;
+}
+
+std::vector<u32> DecodeGeneric(TextureFormat format, const std::vector<u8>& src, int width,
+                               int height, const std::vector<u8>& tlut, TLUTFormat tlut_format)
+{
+  std::vector<u32> dst(static_cast<size_t>(width) * height);
+  TexDecoder_DecodeImpl_Generic(dst.data(), src.data(), width, height, format, tlut.data(),
+                                tlut_format);
+  return dst;
+}
+
+// The instruction sets the decoders have paths for, as far as the host supports them.
+std::vector<std::string> GetSupportedPaths()
+{
+  std::vector<std::string> paths;
+  if (cpu_info.bAVX2)
+    paths.push_back("AVX2");
+  if (cpu_info.bSSSE3)
+    paths.push_back("SSSE3");
+  paths.push_back("SSE2");
+  return paths;
+}
+}  // namespace
+
+class TextureDecoderTest : public testing::TestWithParam<std::string>
+{
+protected:
+  void SetUp() override
+  {
+    m_cpu_info = cpu_info;
+    if (GetParam() != "AVX2")
+      cpu_info.bAVX2 = false;
+    if (GetParam() == "SSE2")
+      cpu_info.bSSSE3 = false;
+  }
+
+  void TearDown() override { cpu_info = m_cpu_info; }
+
+  CPUInfo m_cpu_info;
+};
+
+TEST_P(TextureDecoderTest, MatchesGenericDecoder)
+{
+  std::mt19937 rng(0);
+  for (TextureFormat format : FORMATS)
+  {
+    const int block_width = TexDecoder_GetBlockWidthInTexels(format);
+    const int block_height = TexDecoder_GetBlockHeightInTexels(format);
+    for (int i = 0; i < 32; i++)
+    {
+      // Decoders only get sizes padded to whole blocks.
+      const int width = block_width * static_cast<int>(1 + rng() % 24);
+      const int height = block_height * static_cast<int>(1 + rng() % 24);
+      const std::vector<u8> src = CreateRandomData(
+          TexDecoder_GetTextureSizeInBytes(width, height, format), i % 2 != 0, rng);
+      // Large enough for C14X2.
+      const std::vector<u8> tlut = CreateRandomData(2 << 14, i % 2 != 0, rng);
+
+      for (TLUTFormat tlut_format : TLUT_FORMATS)
+      {
+        EXPECT_EQ(DecodeGeneric(format, src, width, height, tlut, tlut_format),
+                  Decode(format, src, width, height, tlut, tlut_format))
+            << fmt::format("{} {}x{}, TLUT format {}", GetName(format), width, height,
+                           static_cast<int>(tlut_format));
+
+        // The TLUT format doesn't matter for the other formats.
+        if (!IsPaletted(format))
+          break;
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SupportedPaths, TextureDecoderTest, testing::ValuesIn(GetSupportedPaths()),
+    [](const testing::TestParamInfo<std::string>& path) { return path.param; });
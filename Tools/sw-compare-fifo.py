@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+
+# Checks that two builds of the Software renderer produce identical output by playing back a FIFO
+# log with each build's dolphin-emu-nogui, dumping every frame as an image and comparing the dumps.
+#
+# Example usage:
+# $ Tools/sw-compare-fifo.py reference/dolphin-emu-nogui build/Binaries/dolphin-emu-nogui game.dff
+
+import argparse
+import filecmp
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def frame_number(name):
+    return int(re.search(r'(\d+)\.png$', name).group(1))
+
+
+def dump_frames(dolphin, fifo_log, user, duration):
+    # Frame dumping is still read from Dolphin.ini rather than the layered config, so it can't be
+    # enabled with -C.
+    os.makedirs(os.path.join(user, 'Config'), exist_ok=True)
+    with open(os.path.join(user, 'Config', 'Dolphin.ini'), 'w') as ini:
+        ini.write('[Movie]\nDumpFrames = True\nDumpFramesSilent = True\n')
+
+    args = [dolphin, '-u', user, '-p', 'headless', '-v', 'Software Renderer', '-e', fifo_log,
+            '-C', 'Graphics.Settings.DumpFramesAsImages=True']
+    process = subprocess.Popen(args, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    time.sleep(duration)
+    process.terminate()
+    try:
+        process.wait(timeout=10)
+    except subprocess.TimeoutExpired:
+        process.kill()
+
+    dump_dir = os.path.join(user, 'Dump', 'Frames')
+    if not os.path.isdir(dump_dir):
+        sys.exit('{} did not dump any frames'.format(dolphin))
+    return dump_dir, [f for f in os.listdir(dump_dir) if f.endswith('.png')]
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare Software renderer frame dumps of a FIFO log between two builds.')
+    parser.add_argument('reference', help='path to the reference dolphin-emu-nogui')
+    parser.add_argument('test', help='path to the dolphin-emu-nogui to test')
+    parser.add_argument('fifo_log', help='FIFO log (.dff) to play back')
+    parser.add_argument('--duration', type=float, default=30, help='seconds to run each build')
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        ref_dir, ref_frames = dump_frames(args.reference, args.fifo_log,
+                                          os.path.join(tmp, 'reference'), args.duration)
+        test_dir, test_frames = dump_frames(args.test, args.fifo_log, os.path.join(tmp, 'test'),
+                                            args.duration)
+
+        # The builds may not get equally far in the same time; only compare frames both dumped.
+        common = sorted(set(ref_frames) & set(test_frames), key=frame_number)
+        if not common:
+            sys.exit('The builds have no dumped frames in common')
+        for frame in common:
+            if not filecmp.cmp(os.path.join(ref_dir, frame), os.path.join(test_dir, frame),
+                               shallow=False):
+                print('First difference in {} ({} frames compared)'.format(
+                    frame, common.index(frame) + 1))
+                sys.exit(1)
+        print('{} frames identical'.format(len(common)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+
+# Measures how the Software renderer scales with rasterizer threads by playing back a FIFO log
+# with dolphin-emu-nogui for every thread count and averaging the FPS it reports.
+#
+# Example usage:
+# $ Tools/sw-rasterizer-benchmark.py build/Binaries/dolphin-emu-nogui game.dff --threads 1 2 4 8
+
+import argparse
+import re
+import subprocess
+import sys
+import threading
+import time
+
+FPS_RE = re.compile(r'FPS: ([0-9.]+)')
+
+
+def run(dolphin, fifo_log, threads, warmup, duration, user):
+    args = [dolphin, '-p', 'headless', '-v', 'Software Renderer', '-e', fifo_log,
+            '-C', 'Dolphin.Core.EmulationSpeed=0',
+            '-C', 'Graphics.Settings.SWRasterizerThreads={}'.format(threads)]
+    if user:
+        args += ['-u', user]
+
+    samples = []
+    start = time.monotonic()
+    process = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                               universal_newlines=True)
+
+    def read_output():
+        for line in process.stdout:
+            match = FPS_RE.search(line)
+            # The title is updated once per second; skip samples taken while warming up.
+            if match and time.monotonic() - start >= warmup:
+                samples.append(float(match.group(1)))
+
+    reader = threading.Thread(target=read_output, daemon=True)
+    reader.start()
+    time.sleep(warmup + duration)
+    process.terminate()
+    try:
+        process.wait(timeout=10)
+    except subprocess.TimeoutExpired:
+        process.kill()
+    reader.join(timeout=1)
+
+    if not samples:
+        sys.exit('No FPS output from {} with {} threads'.format(dolphin, threads))
+    return sum(samples) / len(samples)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure Software renderer FPS for each rasterizer thread count.')
+    parser.add_argument('dolphin', help='path to dolphin-emu-nogui')
+    parser.add_argument('fifo_log', help='FIFO log (.dff) to play back')
+    parser.add_argument('--threads', type=int, nargs='+', default=[1, 2, 4, 8],
+                        help='rasterizer thread counts to measure')
+    parser.add_argument('--warmup', type=float, default=5, help='seconds to skip at startup')
+    parser.add_argument('--duration', type=float, default=20, help='seconds to measure')
+    parser.add_argument('--user', help='user directory to run Dolphin with')
+    args = parser.parse_args()
+
+    print('threads      fps  speedup')
+    baseline = None
+    for threads in args.threads:
+        fps = run(args.dolphin, args.fifo_log, threads, args.warmup, args.duration, args.user)
+        if baseline is None:
+            baseline = fps
+        print('{:7d} {:8.1f} {:7.2f}x'.format(threads, fps, fps / baseline))
+        sys.stdout.flush()
+
+
+if __name__ == '__main__':
+    main()